@@ -105,7 +105,7 @@
 /* Minimum int field for the value of a semaphore address in the ASL */
 #define LEASTINT	0x00000000
 
-/* Maximum string length for transmitting to device */
+/* Maximum string length for a single transfer to or from a device (longer SYS11/SYS12 strings are output in pieces of this size) */
 #define MAXSTRLEN    128
 
 /* Maximum number of external (sub)devices in UMPS3, plus one additional semaphore to support
@@ -151,7 +151,7 @@ the accumulated CPU time field for a process that is instantiated */
 #define ERRORCONST		-1			/* constant denoting an error occurred in the caller's request */
 #define SUCCESSCONST	0			/* constant denoting that the caller's request completed successfully */
 
-/* Constant to help determine the index in deviceSemaphores/devSemaphores and in the Interrupt Devices Bitmap that a particular device is located at. 
+/* Constant to help determine the index in deviceSemaphores and in the Interrupt Devices Bitmap that a particular device is located at. 
 This constant is subtracted from the line number (or 4, in the case of backing store management), since interrupt lines 3-7 are used for peripheral devices  */
 #define	OFFSET			3	
 
@@ -213,6 +213,21 @@ This constant is subtracted from the line number (or 4, in the case of backing s
 #define SYS11NUM        11
 #define SYS12NUM        12
 #define SYS13NUM        13
+#define	SYS14NUM		14		/* read a disk sector */
+#define	SYS15NUM		15		/* write a disk sector */
+#define	SYS16NUM		16		/* read a flash block (through the block cache) */
+#define	SYS17NUM		17		/* write a flash block (through the block cache) */
+#define	SYS18NUM		18		/* sleep for a number of seconds */
+#define	SYS19NUM		19		/* P on a virtual semaphore */
+#define	SYS20NUM		20		/* V on a virtual semaphore */
+#define	SYS21NUM		21		/* attach a shared memory segment */
+#define	SYS22NUM		22		/* detach a shared memory segment */
+#define	SYS23NUM		23		/* pin a range of pages into the Swap Pool */
+#define	SYS24NUM		24		/* unpin a range of pages */
+#define	SYS25NUM		25		/* map a range of flash blocks into the address space */
+#define	SYS26NUM		26		/* write a mapped region's dirty pages back to flash */
+#define	SYS27NUM		27		/* unmap a mapped region */
+#define	SYS28NUM		28		/* write the flash block cache's dirty blocks back to flash */
 
 /* Constant representing the lower bound on which we unblock semaphores and remove them from the ASL */
 #define	SEMA4THRESH		0
@@ -226,6 +241,30 @@ This constant is subtracted from the line number (or 4, in the case of backing s
 /* Constant that represents when the first four bits in a terminal device's device register's status field are turned on */
 #define	STATUSON		0x0F
 
+/* Constants for the Nucleus' output rings: a spool for each printer and a transmit ring for each terminal. A writer waiting for room in
+a full ring is woken once the ring has drained to half of its size, so that it is not woken for every character output */
+#define PRNTSPOOLSIZE	1024
+#define TERMRINGSIZE	256
+#define OUTRINGCNT		(2 * DEVPERINT)
+#define OUTRING(L, D)	((((L) - PRNTINT) * DEVPERINT) + (D))	/* the output ring of device D on line L (PRNTINT or TERMINT) */
+#define NOOUTERR		0
+
+/* Constants for the Nucleus' per-device request queues, which hold the commands waiting for each disk and flash device. The queue's
+first request is the one the device is performing, and the next is issued from IOInt() as soon as it completes */
+#define REQQCNT			(2 * DEVPERINT)
+#define REQQ(L, D)		((((L) - DISKINT) * DEVPERINT) + (D))	/* the request queue of device D on line L (DISKINT or FLASHINT) */
+
+/* Constants for the Nucleus' per-terminal input rings, which hold the characters a terminal has received until a U-proc reads them a
+line at a time. A backspace (or delete) removes the last character of the line being typed, and a full ring counts as a complete line */
+#define TERMINSIZE		256
+#define RECEIVECHAR		2
+#define CHARRECV		5
+#define NEWLINE			'\n'
+#define BACKSPACE		0x08
+#define DELETECHAR		0x7F
+#define TERMCHARSHIFT	8
+#define TERMCHARMASK	0xFF
+
 /* Phase 3 constant that defines how many user processes can be running at once */
 #define UPROCMAX		1
 
@@ -236,15 +275,219 @@ This constant is subtracted from the line number (or 4, in the case of backing s
 #define GETVPN			0xFFFFF000		/* Constant for setting all of the non-VPN bits in a TLB entry to 0 */
 #define	VPNSHIFT		12				/* Number of bits needed to shift the VPN field of EntryLo over to the right so that we can read the VPN directly */
 
+/* Constants used by the software TLB, a direct-mapped cache of Page Table entries (indexed by a hash of their VPN and ASID) that the
+TLB-Refill handler checks before walking the Current Process' Page Table */
+#define	STLBSIZE		256				/* the number of entries in the software TLB (a power of two) */
+#define	STLBHASH(HI)	(((((HI) >> VPNSHIFT) ^ ((HI) >> ASIDSHIFT))) & (STLBSIZE - 1))	/* the software TLB entry that may cache the Page Table entry with EntryHI field HI */
+#define	STLBNOENTRY		ALLOFF			/* the EntryHI field of an unused software TLB entry (VPN 0 never lies in KUSEG) */
+
+/* Constants used to manage the TLB directly, rather than erasing all of its entries whenever a Page Table entry changes */
+#define	TLBWIREDCNT		1				/* the number of TLB entries loaded with the stack page of each U-proc that is dispatched (TLBWR only avoids entry 0, so no other entry stays wired) */
+#define	WIREDSTACKSLOT	0				/* the TLB entry loaded with the dispatched U-proc's stack page */
+#define	TLBINDEXSHIFT	8				/* the number of bits the TLB entry number is shifted left by in the Index register */
+#define	TLBPROBEFAIL	0x80000000		/* the bit in the Index register that TLBP turns on when no TLB entry matches EntryHI */
+
 /* Constant that represents the number of sharable peripheral I/O devices */
 #define	MAXIODEVICES	48		
 
 /* Constant that represents the ASID of a frame is unoccupied */
 #define	EMPTYFRAME		-1
 
+/* Constants that represent the state of a frame in the Swap Pool, so that flash I/O can be performed without holding the Swap Pool semaphore */
+#define	FRAMEIDLE		0				/* the frame has no flash transfer in progress */
+#define	FRAMEBUSY		1				/* the frame has been reserved by the Pager and is in transit to or from a flash device */
+
+/* Constant that represents that no frame in the Swap Pool matches a search */
+#define	NOFRAME			-1
+
+/* Constant that represents the initial value of each frame's synchronization semaphore */
+#define	INITIALFRAMESEM	0
+
+/* Constants that control the Pager's read-ahead of adjacent logical pages on sequential page faults */
+#define	READAHEADMAX	4				/* the largest number of pages that are prefetched after a single sequential page fault */
+#define	READAHEADINIT	2				/* the number of pages that are prefetched after a U-proc's first sequential page fault */
+#define	NOPAGE			-1				/* constant that represents that a U-proc has not yet faulted on any page */
+
+/* Constants that control the page cleaner daemon, which writes dirty frames back to flash before they are selected for replacement */
+#define	CLEANAHEAD		UPROCMAX		/* the number of frames ahead of the FIFO page replacement algorithm's position that the page cleaner examines */
+#define	CLEANWATERMARK	UPROCMAX		/* the Pager wakes the page cleaner when fewer than this many frames can be replaced without a flash write */
+
+/* Constants that control the Pager's load control (i.e., the suspension of whole U-procs when the system is thrashing) */
+#define	THRASHFAULTS	(2 * MAXFRAMECNT)	/* the number of page faults per Pseudo-clock tick above which the system is considered to be thrashing */
+#define	RESUMEFAULTS	(MAXFRAMECNT / 2)	/* the number of page faults per Pseudo-clock tick below which a suspended U-proc is resumed */
+#define	LCACTIVE		0				/* the U-proc is competing for frames in the Swap Pool */
+#define	LCPENDING		1				/* the U-proc has been chosen for suspension and is suspended at its next page fault */
+#define	LCSUSPENDED		2				/* the U-proc has released its frames and is waiting to be resumed */
+#define	LCEXITED		3				/* the U-proc has terminated */
+#define	NOUPROC			0				/* constant that represents that no U-proc has been chosen (U-proc ASIDs start at 1) */
+
+/* Constants that describe the compressed page cache, a region of RAM (following the Swap Pool) that holds compressed copies of evicted
+dirty pages so that they need not be written to, or read back from, flash */
+#define	ZCACHEPAGES		4				/* the number of pages of RAM reserved for compressed pages */
+#define	ZCACHEADDR		(SWAPPOOLADDR + (MAXFRAMECNT * PAGESIZE))	/* the starting address of the compressed page cache */
+#define	ZBOUNCEADDR		(ZCACHEADDR + (ZCACHEPAGES * PAGESIZE))		/* the starting address of the page into which the page cleaner decompresses pages before writing them to flash */
+#define	ZCHUNKWORDS		64				/* the number of words in each chunk of the compressed page cache */
+#define	ZCHUNKCNT		((ZCACHEPAGES * PAGESIZE) / (ZCHUNKWORDS * WORDLEN))	/* the number of chunks in the compressed page cache */
+#define	ZENTRYCNT		ZCHUNKCNT		/* the largest number of pages that the compressed page cache can hold */
+#define	ZMAXWORDS		((PAGESIZE / WORDLEN) / 2)	/* a page is only cached if it compresses to at most this many words (i.e., half a page) */
+#define	ZCLEANCHUNKS	(ZMAXWORDS / ZCHUNKWORDS)	/* the page cleaner writes cached pages back to flash until at least this many chunks are free */
+#define	ZMINRUN			3				/* the shortest run of identical words that is compressed */
+#define	ZRUNBIT			0x80000000		/* the bit of a compressed token's header word that indicates a run of identical words */
+#define	ZCOUNTMASK		0x7FFFFFFF		/* constant for extracting the number of words from a compressed token's header word */
+#define	ZFREE			0				/* the compressed page cache entry is unused */
+#define	ZCACHED			1				/* the compressed page cache entry holds a compressed page */
+#define	ZWRITING		2				/* the compressed page cache entry's page is being written to flash by the page cleaner */
+#define	NOZENTRY		-1				/* constant that represents that a page is not in the compressed page cache */
+#define	NOCHUNK			-1				/* constant that marks the end of a list of chunks */
+
+/* Constants used to implement the disk syscalls (SYS14 and SYS15). Each U-proc has its own DMA buffer page (following the page
+cleaner's bounce page), so that copying a sector or block between the buffer and the U-proc's address space does not hold up the disk
+(or the flash block cache) */
+#define	DMABUFADDR		(ZBOUNCEADDR + PAGESIZE)	/* the starting address of the first U-proc's DMA buffer */
+#define	DMABUF(A)		(DMABUFADDR + (((A) - 1) * PAGESIZE))	/* the starting address of the DMA buffer of the U-proc whose ASID is A */
+#define	SEEKCYL			2				/* the disk command code for moving the boom to a cylinder */
+#define	DISKREADBLK		3				/* the disk command code for reading a sector */
+#define	DISKWRITEBLK	4				/* the disk command code for writing a sector */
+#define	DISKCYLSHIFT	8				/* the number of bits needed to shift the cylinder number over to the left in a SEEKCYL command */
+#define	DISKHEADSHIFT	16				/* the number of bits needed to shift the head number over to the left in a read or write command */
+#define	DISKSECTSHIFT	8				/* the number of bits needed to shift the sector number over to the left in a read or write command */
+#define	MAXCYLSHIFT		16				/* the number of bits needed to shift a disk's DATA1 field over to the right to obtain its number of cylinders */
+#define	MAXHEADSHIFT	8				/* the number of bits needed to shift a disk's DATA1 field over to the right to obtain its number of heads */
+#define	DISKGEOMASK		0xFF			/* constant for extracting a disk's number of heads or sectors per track from its DATA1 field */
+#define	NOCYL			-1				/* constant that represents that the cylinder a disk's boom is positioned over is not known */
+#define	NODISK			-1				/* constant that represents that a U-proc is not waiting for a disk */
+
+/* Constants used to implement the flash block cache, which holds BCACHECNT blocks of the flash devices other than the swap devices
+(in the pages following the U-procs' DMA buffers) for the flash syscalls (SYS16 and SYS17). Blocks written by SYS17 are only written
+back to flash when they are evicted, when the flush daemon runs (every BCFLUSHTICKS Pseudo-clock ticks), on SYS28 or when a U-proc terminates */
+#define	BCACHECNT		4				/* the number of blocks the cache holds */
+#define	BCACHEADDR		(DMABUFADDR + (UPROCMAX * PAGESIZE))	/* the starting address of the cache's first buffer */
+#define	BCFLUSHTICKS	10				/* the number of Pseudo-clock ticks (i.e., one second) between runs of the flush daemon */
+#define	NOBCENTRY		-1				/* constant that represents that a block is not in the cache */
+#define	ISSWAPDEV(D)	(((D) >= SWAPDEVBASE) && ((D) < SWAPDEVBASE + SWAPDEVCNT))	/* TRUE if flash device D is a swap device */
+
+/* Constants that describe the timer wheel on which U-procs sleeping in SYS18 wait. The wheel has two levels of TWSLOTS slots: a sleeper
+due within TWSLOTS Pseudo-clock ticks waits in the level 0 slot of its tick, and a later one in the level 1 slot of its span of TWSLOTS
+ticks, from which it is moved to level 0 when that span begins (sleepers due beyond both levels wait in the last level 1 slot) */
+#define	TWSLOTS			64				/* the number of slots in each level of the wheel */
+#define	TWLEVELS		2				/* the number of levels in the wheel */
+#define	TICKSPERSEC		(1000000 / INITIALINTTIMER)	/* the number of Pseudo-clock ticks per second */
+
+/* Constants that describe the support level's ASL for virtual semaphores (SYS19 and SYS20). A semaphore descriptor is keyed by the ASID
+of its U-proc and its virtual address, except that a semaphore in a segment attached SHMSHARED is keyed by VSEMSHAREDASID, so that every
+U-proc attaching the segment names the same semaphore. Each U-proc waits on at most one semaphore, so UPROCMAX descriptors suffice */
+#define	VSEMHASHSIZE	16				/* the number of buckets in the hash table of active semaphore descriptors */
+#define	VSEMHASH(A, V)	((((V) >> 2) ^ (A)) % VSEMHASHSIZE)	/* the bucket of the descriptor of the semaphore at virtual address V keyed by ASID A */
+#define	VSEMSHAREDASID	0				/* the ASID by which semaphores in shared segments are keyed (U-proc ASIDs start at 1) */
+
+/* Constants that describe the layout of each U-proc's two-level Page Table. Logical page numbers 0 through LOWPGMAX - 1 map the VPNs
+starting at KUSEG (i.e., .text, .data and .bss), while the last STACKPGMAX logical page numbers map the VPNs growing down from the stack
+page. Each entry of a U-proc's page directory points to a table of ENTRIESPERPG Page Table entries, and the logical page number is also
+the block of the U-proc's flash device that holds the page's contents in the load image. */
+#define	PGDIRSIZE		8				/* the number of entries in a U-proc's page directory */
+#define	MAXUPAGES		(PGDIRSIZE * ENTRIESPERPG)	/* the number of logical pages in a U-proc's address space (each U-proc's flash device must have at least this many blocks) */
+#define	STACKPGMAX		ENTRIESPERPG	/* the largest number of stack pages, all of which are covered by the last entry of the page directory */
+#define	LOWPGMAX		(MAXUPAGES - STACKPGMAX)	/* the number of logical pages available for .text, .data and .bss */
+#define	STACKREGIONVPN	(STACKPGVPN - STACKPGMAX + 1)	/* the lowest VPN in the stack region */
+#define	PGTBLPOOLSIZE	(UPROCMAX * (PGDIRSIZE - 1))	/* the number of tables of Page Table entries allocated on demand (enough for every U-proc to fill its page directory) */
+
+/* Macros that translate between a VPN in KUSEG and a U-proc's logical page number (NOPAGE if the VPN lies outside the U-proc's address space) */
+#define	VPNTOPGNO(V)	((((V) >= STACKREGIONVPN) && ((V) <= STACKPGVPN)) ? (MAXUPAGES - 1 - (STACKPGVPN - (V))) : ((((V) >= VPNSTART) && ((V) < VPNSTART + LOWPGMAX)) ? ((V) - VPNSTART) : NOPAGE))
+#define	PGNOTOVPN(P)	(((P) >= LOWPGMAX) ? (STACKPGVPN - (MAXUPAGES - 1 - (P))) : (VPNSTART + (P)))
+
+/* Constants that control the demand growth of each U-proc's stack */
+#define	STACKLIMITINIT	8				/* the largest number of stack pages that a U-proc may grow its stack to (at most STACKPGMAX) */
+#define	STACKGAPPGS		1				/* the number of pages below the current bottom of the stack that a page fault may land on and still grow the stack */
+
+/* Constants used to share the read-only .text pages of U-procs that run the same load image. A load image is identified by reading its
+.text blocks into the two pages following the flash block cache's buffers, and is only given the identifier of another U-proc's load
+image if their hashes match and their blocks compare equal */
+#define	RMAPPOOLSIZE	((MAXFRAMECNT + SHMWINDOWPGS) * UPROCMAX)	/* the number of reverse map entries (enough for every U-proc to share every frame and map every shared segment page) */
+#define	FNVOFFSET		0x811C9DC5		/* the initial value of the FNV-1a hash used to identify load images */
+#define	FNVPRIME		0x01000193		/* the multiplier of the FNV-1a hash used to identify load images */
+#define	IMAGEBUFADDR	(BCACHEADDR + (BCACHECNT * PAGESIZE))	/* the starting address of the two pages into which .text blocks are read to identify a load image */
+#define	NOIMAGE			0				/* the identifier of a load image whose pages are never shared (e.g., because it has not been identified yet) */
+
+/* Constants used to implement shared memory segments. Segment s is mapped at the same logical pages (SHMBASEPGNO + s * SHMPGMAX
+onwards) in every U-proc that attaches it, just below the stack region, and its pages are swapped as pages SHMBLOCKBASE + s * SHMPGMAX
+onwards (beyond the logical pages) of the U-proc that created it */
+#define	SHMSEGMAX		4				/* the number of shared memory segments */
+#define	SHMPGMAX		4				/* the largest number of pages in a shared memory segment */
+#define	SHMWINDOWPGS	(SHMSEGMAX * SHMPGMAX)	/* the number of logical pages reserved for shared memory segments in each U-proc's address space */
+#define	SHMBASEPGNO		(LOWPGMAX - SHMWINDOWPGS)	/* the first logical page reserved for shared memory segments */
+#define	SHMBLOCKBASE	MAXUPAGES		/* the page number under which the first page of the first shared memory segment is swapped */
+#define	SHMNOKEY		-1				/* constant that marks a shared memory segment as unused */
+#define	NOSEG			-1				/* constant that represents that a frame does not hold a page of a shared memory segment */
+#define	SHMDETACHED		0				/* a U-proc has not attached the segment */
+#define	SHMSHARED		1				/* a U-proc has attached the segment, and its stores are seen by every U-proc attaching the segment */
+#define	SHMCOW			2				/* a U-proc has attached the segment copy-on-write, so its first store into a page gives it a private copy */
+
+/* Constants used to implement memory-mapped flash regions. Region r of a U-proc is mapped at logical pages MMAPBASEPGNO + r * MMAPPGMAX
+onwards, just below the shared memory segment window, and its pages are read from (and written back to) the blocks of the flash device
+it maps rather than the U-proc's load image or swap. Only the flash devices that follow the swap devices may be mapped */
+#define	MMAPMAX			2				/* the number of regions that each U-proc may map */
+#define	MMAPPGMAX		4				/* the largest number of pages in a mapped region */
+#define	MMAPWINDOWPGS	(MMAPMAX * MMAPPGMAX)	/* the number of logical pages reserved for mapped regions in each U-proc's address space */
+#define	MMAPBASEPGNO	(SHMBASEPGNO - MMAPWINDOWPGS)	/* the first logical page reserved for mapped regions */
+#define	MMAPDEVBASE		(SWAPDEVBASE + SWAPDEVCNT)	/* the device number of the first flash device that may be mapped */
+#define	NOREGION		-1				/* constant that represents that a page does not belong to a mapped region */
+
+/* Constants that describe the swap area. Dirty pages are written to swap slots on SWAPDEVCNT flash devices that follow the U-procs'
+flash devices, rather than to the U-procs' own flash devices, which only hold their load images. The machine must therefore be configured
+with flash devices 0 through UPROCMAX - 1 holding the U-procs' load images, flash devices SWAPDEVBASE through SWAPDEVBASE + SWAPDEVCNT - 1
+(each at least SWAPDEVBLOCKS blocks long) for swap, and any devices from MMAPDEVBASE onwards for mapped regions, so that UPROCMAX +
+SWAPDEVCNT may not exceed DEVPERINT (i.e., at most 6 U-procs are supported with 2 swap devices). The slots are grouped into clusters of
+SWAPCLUSTER adjacent blocks, and consecutive clusters lie on consecutive swap devices, so that the page cleaner writes a burst of pages
+to one device while the next burst goes to another */
+#define	SWAPDEVBASE		UPROCMAX		/* the device number of the first swap device */
+#define	SWAPDEVCNT		2				/* the number of swap devices */
+#define	SWAPDEVBLOCKS	64				/* the number of blocks of each swap device used for swap slots */
+#define	SWAPCLUSTER		4				/* the number of adjacent swap slots in a cluster (i.e., the largest burst written by the page cleaner) */
+#define	SWAPSLOTCNT		(SWAPDEVCNT * SWAPDEVBLOCKS)	/* the number of swap slots */
+#define	SWAPCLUSTERCNT	(SWAPSLOTCNT / SWAPCLUSTER)	/* the number of clusters of swap slots */
+#define	SLOTMAPSIZE		(MAXUPAGES + SHMWINDOWPGS)	/* the number of pages of each U-proc that may be swapped (its logical pages and the segment pages it created) */
+#define	NOSLOT			-1				/* constant that represents that a page has no swap slot */
+#define	SWAPFULL		-1				/* the status returned in place of a device's status when a page could not be given a swap slot */
+#define	SLOTTODEV(S)	(SWAPDEVBASE + (((S) / SWAPCLUSTER) % SWAPDEVCNT))	/* the swap device holding swap slot S */
+#define	SLOTTOBLOCK(S)	(((((S) / SWAPCLUSTER) / SWAPDEVCNT) * SWAPCLUSTER) + ((S) % SWAPCLUSTER))	/* the block of the swap device holding swap slot S */
+#if (UPROCMAX + SWAPDEVCNT) > DEVPERINT
+#error "the U-procs' flash devices and the swap devices must fit on the flash interrupt line"
+#endif
+
+/* Constants that control the pinning of pages into the Swap Pool (i.e., frames that the Pager never selects for replacement). At most
+PINFRAMEMAX pages are pinned by U-procs at any time, which leaves enough frames unpinned for the pages that the support level pins
+while a U-proc's buffer is used for device I/O (at most one per U-proc) and for the page fault of the U-proc touching its next page */
+#define	PINQUOTA		2				/* the largest number of pages that each U-proc may pin */
+#define	PINFRAMEMAX		(MAXFRAMECNT - UPROCMAX)	/* the largest number of pages that all U-procs together may pin */
+
+/* Constant that determines whether test() preloads each U-proc's .text and .data pages into the Swap Pool before launching it (TRUE),
+or whether they are left to be brought in by the Pager one page fault at a time (FALSE) */
+#define	PRELOADUPROCS	FALSE
+
+/* Constants that represent the word offsets of fields in the aout header, which is located at the start of block 0 of a U-proc's flash device */
+#define	AOUTDATAVADDR	6				/* the word holding the starting logical address of the .data section */
+#define	AOUTDATAFILESZ	9				/* the word holding the size (in bytes) of the .data section in the load image */
+
+/* Constant that represents that the Pager has not yet read a U-proc's aout header, so the bounds of its load image are unknown */
+#define	IMAGEUNKNOWN	-1
+
+/* Constant for setting all of the non-PFN bits in the EntryLo portion of a Page Table entry to 0, leaving the frame's physical address */
+#define	GETPFN			0xFFFFF000
+
+/* Software-only bits in the EntryLo portion of a Page Table entry. uMPS3 ignores bits 0-7 of EntryLo, so the TLB-Refill handler
+uses one of them to record that a page has been referenced since it was mapped, and the Pager uses the others to record that a page has
+been written to swap at least once and that a copy-on-write page has become private; they are masked off before the entry is written into the TLB */
+#define	PTEREFBITON		0x00000001		/* Constant for setting all of the bits to 0 in the EntryLo portion of a Page Table entry except for the software reference bit */
+#define	PTEBACKEDBITON	0x00000002		/* Constant for setting all of the bits to 0 in the EntryLo portion of a Page Table entry except for the software bit recording that the page has been written to swap */
+#define	PTECOPIEDBITON	0x00000004		/* Constant for setting all of the bits to 0 in the EntryLo portion of a Page Table entry except for the software bit recording that a copy-on-write page of a shared segment has been copied */
+#define	PTEHWBITS		0xFFFFFF00		/* Constant for setting all of the software-only bits in the EntryLo portion of a Page Table entry to 0 */
+
 /* Constant that represents the top of the stack for handling general exceptions and TLB exceptions, with each of these handlers having their own stack area */
 #define	TOPOFSTACK		499
 
+/* Constant that represents the size (in words) of the stack area of each support level daemon process */
+#define	DAEMONSTACKSIZE	(TOPOFSTACK + 1)
+
 /* Constants that denote important addresses when initializing a U-proc's initial processor state */
 #define	UPROCPC			0x800000B0		/* the address of a U-proc's PC; this address is the address of the start of the .text section */
 #define	UPROCSP			0xC0000000		/* the address of a U-proc's stack pointer */
@@ -259,7 +502,13 @@ This constant is subtracted from the line number (or 4, in the case of backing s
 #define	DBITON			0x00000400		/* Constant for setting all of the bits to 0 in the EntryLo portion of a TLB entry except for the D bit (i.e., D (bit 10) = 1) */
 
 /* Constant that represents the maximum number of frames in phase 3 */
-#define	MAXFRAMECNT		2 * UPROCMAX
+#define	MAXFRAMECNT		(2 * UPROCMAX)
+
+/* the page cleaner examines the frames (nextFrameNo + 1) % MAXFRAMECNT through (nextFrameNo + CLEANAHEAD) % MAXFRAMECNT, which must
+all be distinct */
+#if CLEANAHEAD >= MAXFRAMECNT
+#error "CLEANAHEAD must be smaller than MAXFRAMECNT"
+#endif
 
 /* Constant representing the exception code that signfifies that a TLB-Modification Exception occurred */
 #define	TLBMODEXCCODE	1
@@ -267,6 +516,9 @@ This constant is subtracted from the line number (or 4, in the case of backing s
 /* Constant for setting all of the bits to 1 in the EntryLo portion of a TLB entry except for the V bit */
 #define	VBITOFF			0xFFFFFDFF
 
+/* Constant for setting all of the bits to 1 in the EntryLo portion of a TLB entry except for the D bit */
+#define	DBITOFF			0xFFFFFBFF
+
 /* Constants to signify whether one wishes to read or write to a flash device; these constants serve as potential parameters to the flashOperation() function in vmSupport.c */
 #define	WRITE			0				/* Constant that represents the parameter to flashOperation() for writing a flash device */
 #define	READ			1 				/* Constant that represents the parameter to flashOperation() for reading a flash device */
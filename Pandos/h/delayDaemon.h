@@ -0,0 +1,19 @@
+#ifndef DELAYDAEMON
+#define DELAYDAEMON
+
+/**************************************************************************** 
+ *
+ * The externals declaration file for the module that implements SYS18 and
+ * the delay daemon, which wakes the sleeping U-procs from a timer wheel
+ * 
+ * Written by: Kollen Gruizenga and Jake Heyser
+ * 
+ ****************************************************************************/
+
+#include "../h/types.h"
+
+extern void initDelayStructs();
+extern void delayUProc(int asid, int secs);
+extern void delayDaemon();
+
+#endif
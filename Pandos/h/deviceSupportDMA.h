@@ -0,0 +1,27 @@
+#ifndef DEVICESUPPORTDMA
+#define DEVICESUPPORTDMA
+
+/**************************************************************************** 
+ *
+ * The externals declaration file for the module that performs disk and
+ * flash I/O on behalf of the U-procs, serving each disk's waiting requests
+ * in C-LOOK elevator order and reading and writing flash blocks through a
+ * block cache
+ * 
+ * Written by: Kollen Gruizenga and Jake Heyser
+ * 
+ ****************************************************************************/
+
+#include "../h/types.h"
+
+extern void initDeviceStructs();
+extern int diskSectorCnt(int diskNo);
+extern int diskOperation(int readOrWrite, int diskNo, int sectNo, memaddr virtAddr, support_t *supportStruct);
+extern int flashBlockCnt(int devNo);
+extern int bcacheOperation(int readOrWrite, int devNo, int blockNo, memaddr virtAddr, support_t *supportStruct);
+extern int bcacheLookup(int devNo, int blockNo, memaddr frameAddress);
+extern void bcacheDiscard(int devNo, int blockNo);
+extern int bcacheFlush();
+extern void bcacheFlushDaemon();
+
+#endif
@@ -3,7 +3,9 @@
 
 /**************************************************************************** 
  *
- * The externals declaration file for the TLB-Refill exception handler module
+ * The externals declaration file for the TLB-Refill exception handler module,
+ * including the functions that keep the TLB and the software TLB consistent
+ * with the Page Tables and the TLB statistics
  * 
  * Written by: Kollen Gruizenga and Jake Heyser
  * 
@@ -16,5 +18,10 @@ extern void tlbTrapH ();
 extern void pgmTrapH ();
 extern void updateCurrPcb();
 extern void uTLB_RefillHandler();
+extern void tlbInvalidate(pte_entry_t *pte);
+extern void tlbFlush();
+extern void loadWiredTlb(pcb_PTR proc);
+extern int tlbRefillCnt;
+extern int stlbHitCnt;
 
 #endif
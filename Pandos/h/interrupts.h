@@ -12,5 +12,14 @@
 
 
 extern void intTrapH();
+extern void outInit();
+extern int outEnqueue(int lineNum, int devNo, char *buf, int len);
+extern int outDrain(int lineNum, int devNo);
+extern int outTakeError(int lineNum, int devNo);
+extern void inInit();
+extern int inWait(int devNo);
+extern int inDequeue(int devNo, char *buf);
+extern void reqInit();
+extern void reqSubmit(int lineNum, int devNo, devreq_t *req);
 
 #endif
\ No newline at end of file
@@ -68,19 +68,103 @@ typedef struct context_t {
 					c_pc;		/* PC address */
 } context_t;
 
+/* type representing an additional mapping of a shared frame in the Swap Pool (i.e., a reverse map entry) */
+typedef struct rmap_t {
+	struct rmap_t	*r_next;	/* pointer to the next mapping of the same frame (or to the next free entry) */
+	int				r_asid;		/* the ASID of the U-proc sharing the frame */
+	pte_entry_t		*r_pte;		/* a pointer to the sharing U-proc's Page Table entry that maps the frame */
+} rmap_t;
+
 /* type representing the table of entries whose frames are in the Swap Pool (i.e., the Swap Pool table)*/
 typedef struct swap_t {
 	int				asid; 		/* the ASID of the U-Proc whose page is occupying the frame */
 	int				pgNo; 		/* the logical page number of the occupying page */
 	pte_entry_t		*ownerProc;	/* a pointer to the matching Page Table entry in the Page Table belonging directly to the owner process */
+	int				frameState;	/* whether the frame is idle (FRAMEIDLE) or has a flash transfer in progress (FRAMEBUSY) */
+	int				evictAsid;	/* the ASID of the U-Proc whose page is being written out of the frame while it is in transit */
+	int				evictPgNo;	/* the logical page number of the page being written out of the frame while it is in transit */
+	int				frameSem;	/* synchronization semaphore on which processes faulting on a page that is in transit wait */
+	int				waitCnt;	/* the number of processes currently waiting on frameSem */
+	int				prefetched;	/* TRUE if the frame's page was read in by the Pager's read-ahead rather than on demand */
+	int				dirty;		/* TRUE if the frame's page has been modified since it was last read from or written to flash */
+	int				shareable;	/* TRUE if the frame holds a .text page that U-procs running the same load image may share */
+	int				imageId;	/* the identifier of the load image whose .text page the frame holds (if shareable) */
+	rmap_t			*sharers;	/* the list of mappings of the frame by U-procs other than its owner */
+	int				segNo;		/* the shared memory segment whose page occupies the frame (NOSEG if the page is private) */
+	int				pinCnt;		/* the number of pins held on the frame (the Pager never selects a pinned frame for replacement) */
 } swap_t;
 
+/* type representing a shared memory segment */
+typedef struct shmseg_t {
+	int				key;		/* the key by which U-procs name the segment (SHMNOKEY if the segment is unused) */
+	int				pgCnt;		/* the number of pages in the segment */
+	int				attachCnt;	/* the number of U-procs that have attached the segment (i.e., its reference count) */
+	int				backAsid;	/* the ASID of the U-proc whose flash device backs the segment's pages */
+	pte_entry_t		pgTbl[SHMPGMAX];	/* the segment's own Page Table entries, which own the frames holding its pages */
+} shmseg_t;
+
+/* type representing a load image that the Pager has identified (i.e., an entry in the table of identified load images, indexed by ASID) */
+typedef struct image_t {
+	unsigned int	hash;		/* the hash (FNV-1a) of the load image's pages that hold only .text */
+	int				textPgCnt;	/* the number of logical pages that hold only .text (0 if the load image has not been identified) */
+	int				imageId;	/* the identifier given to the load image */
+} image_t;
+
+/* type representing a range of flash blocks that a U-proc has mapped into its address space */
+typedef struct mmap_t {
+	int				devNo;		/* the flash device whose blocks are mapped */
+	int				firstBlock;	/* the block mapped at the region's first page */
+	int				pgCnt;		/* the number of pages in the region (0 if the region is unused) */
+} mmap_t;
+
+/* type representing a command waiting for (or being performed by) a disk or flash device (i.e., an entry in a device's request queue) */
+typedef struct devreq_t {
+	struct devreq_t	*r_next;	/* the next request in the device's queue */
+	memaddr			r_data0;	/* the value written into the device's DATA0 field before the command is issued */
+	unsigned int	r_command;	/* the value written into the device's COMMAND field */
+} devreq_t;
+
+/* type representing an entry in the flash block cache's table */
+typedef struct bcache_t {
+	int				valid;		/* TRUE if the entry's buffer holds a block */
+	int				devNo;		/* the flash device whose block the buffer holds */
+	int				blockNo;	/* the block the buffer holds */
+	int				dirty;		/* TRUE if the buffer has been written since the block was last read from or written to flash */
+	int				lastUse;	/* when the block was last accessed, so that the least recently used block is evicted first */
+} bcache_t;
+
+/* type representing a descriptor of a virtual semaphore on which U-procs are blocked (i.e., an entry in the support level's ASL) */
+typedef struct vsemd_t {
+	struct vsemd_t	*v_next;	/* the next descriptor in the same hash bucket (or on the free list) */
+	int				v_asid;		/* the ASID by which the semaphore is keyed */
+	memaddr			v_semAdd;	/* the virtual address of the semaphore */
+	int				v_head;		/* the ASID of the first U-proc blocked on the semaphore */
+	int				v_tail;		/* the ASID of the last U-proc blocked on the semaphore */
+} vsemd_t;
+
+/* type representing an entry in the compressed page cache's table */
+typedef struct zcache_t {
+	int				state;		/* whether the entry is unused (ZFREE), holds a page (ZCACHED) or holds a page being written to flash (ZWRITING) */
+	int				asid;		/* the ASID of the U-proc that owns the compressed page */
+	int				pgNo;		/* the logical page number of the compressed page */
+	int				wordCnt;	/* the number of words in the compressed page */
+	int				firstChunk;	/* the first of the chunks holding the compressed page (the rest are linked through the chunk table) */
+	int				seqNo;		/* the order in which the page was cached, so that the page cleaner writes back the oldest page first */
+} zcache_t;
+
 /* Support structure type */
 typedef struct support_t {
 	int				sup_asid;				/* process Id (asid) */
 	state_t			sup_exceptState[2];		/* stored except states */
 	context_t		sup_exceptContext[2];	/* pass up contexts */
-	pte_entry_t		sup_privatePgTbl[32];	/* the user process's page table */
+	pte_entry_t		*sup_pgDir[PGDIRSIZE];	/* the user process's page directory; each entry points to a table of ENTRIESPERPG Page Table entries (or is NULL) */
+	pte_entry_t		sup_privatePgTbl[32];	/* the user process's first table of Page Table entries (i.e., the one pointed to by sup_pgDir[0]) */
+	int				sup_stackPgCnt;			/* the number of stack pages that the U-proc's stack has grown to */
+	int				sup_stackLimit;			/* the largest number of stack pages that the U-proc's stack may grow to */
+	int				sup_shmMode[SHMSEGMAX];	/* how the U-proc has attached each shared memory segment (SHMDETACHED, SHMSHARED or SHMCOW) */
+	int				sup_textPgCnt;			/* the number of logical pages that hold only .text (0 until the aout header is read) */
+	int				sup_imageId;			/* the identifier of the U-proc's load image, which it shares with the U-procs whose .text is identical (NOIMAGE until the load image is identified) */
+	int				sup_imagePgCnt;			/* the number of logical pages spanned by the .text and .data sections of the load image (IMAGEUNKNOWN until the aout header is read) */
 	int				sup_stackTLB[500];		/* the stack area for the process' TLB exception handler */
 	int				sup_stackGen[500];		/* the stack area for the process' general exception handler */
 } support_t;
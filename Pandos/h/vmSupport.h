@@ -6,7 +6,11 @@
  * The externals declaration file for the module containing the TLB exception
  * handler, the functions for reading and writing flash devices, and the function
  * (initSwapStructs) which initializes both the Swap Pool table and the accompanying
- * semaphore
+ * semaphore, the Pager's daemons (read-ahead, page cleaner and
+ * Pseudo-clock) launched by test(), the functions that attach and
+ * detach shared memory segments, the functions that pin pages into
+ * the Swap Pool, and the functions that map flash blocks into a U-proc's
+ * address space
  * 
  * Written by: Kollen Gruizenga and Jake Heyser
  * 
@@ -19,5 +23,32 @@ extern void vmTlbHandler();
 extern void setInterrupts(int onOrOff);
 extern void switchUContext(state_PTR returnState);
 extern void mutex(int opCode, int *semaphore); 
+extern void readAheadDaemon();
+extern void preloadUProc(support_t *supportStruct);
+extern void pageCleanerDaemon();
+extern void pseudoClockDaemon();
+extern void releaseUProcFrames(int asid);
+extern void initPageTable(support_t *supportStruct);
+extern int shmAttach(support_t *supportStruct, int key, int pgCnt, int mode);
+extern int shmDetach(support_t *supportStruct, int key);
+extern void shmDetachAll(support_t *supportStruct);
+extern int pinUserPage(support_t *supportStruct, memaddr vAddr);
+extern void unpinFrame(int frameNo);
+extern int pinDmaPage(support_t *supportStruct, memaddr vAddr, int readOrWrite);
+extern void unpinDmaFrame(int frameNo, int readOrWrite);
+extern int validRange(support_t *supportStruct, memaddr vAddr, int len, int forStore);
+extern int copyIn(support_t *supportStruct, char *dest, memaddr src, int len);
+extern int copyOut(support_t *supportStruct, memaddr dest, char *src, int len);
+extern int pinRange(support_t *supportStruct, memaddr vAddr, int len);
+extern void unpinPages(support_t *supportStruct, memaddr vAddr, int len);
+extern int mmapMap(support_t *supportStruct, int devNo, int firstBlock, int pgCnt);
+extern int mmapSync(support_t *supportStruct, int regionNo);
+extern int mmapUnmap(support_t *supportStruct, int regionNo);
+extern void mmapUnmapAll(support_t *supportStruct);
+extern int mmapDevMapped(int devNo);
+extern int flashTransfer(int readOrWrite, int devNo, memaddr frameAddress, int blockNum);
+extern int pageWritable(support_t *supportStruct, memaddr vAddr);
+extern int makeWritable(support_t *supportStruct, memaddr vAddr);
+extern int pgFaultCnt;
 
 #endif
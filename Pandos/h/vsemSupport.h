@@ -0,0 +1,20 @@
+#ifndef VSEMSUPPORT
+#define VSEMSUPPORT
+
+/**************************************************************************** 
+ *
+ * The externals declaration file for the module that implements the virtual
+ * semaphores of SYS19 and SYS20, along with the support level's ASL on
+ * which the U-procs blocked on them wait
+ * 
+ * Written by: Kollen Gruizenga and Jake Heyser
+ * 
+ ****************************************************************************/
+
+#include "../h/types.h"
+
+extern void initVsemStructs();
+extern int vsemP(support_t *supportStruct, memaddr semAdd);
+extern int vsemV(support_t *supportStruct, memaddr semAdd);
+
+#endif
@@ -0,0 +1,128 @@
+/**************************************************************************** 
+ *
+ * This module implements SYS18 (i.e., delaying the requesting U-proc for a
+ * number of seconds) and the delay daemon that wakes the sleeping U-procs.
+ * A sleeping U-proc waits on its private semaphore, and the ASID of the
+ * U-proc is placed in a slot of a two-level timer wheel that is advanced by
+ * the delay daemon once per Pseudo-clock tick. Placing a sleeper on the
+ * wheel takes constant time, and on each tick the daemon only visits the
+ * sleepers that are due at that tick (all of which it wakes as a batch),
+ * except once every TWSLOTS ticks, when it moves the sleepers due during
+ * the next TWSLOTS ticks from level 1 of the wheel down to level 0. The
+ * cost of a tick therefore does not grow with the number of sleepers.
+ *  
+ * Written by: Kollen Gruizenga and Jake Heyser
+ ****************************************************************************/
+
+#include "../h/asl.h"
+#include "../h/pcb.h"
+#include "../h/scheduler.h"
+#include "../h/exceptions.h"
+#include "../h/interrupts.h"
+#include "../h/initial.h"
+#include "../h/types.h"
+#include "../h/const.h"
+#include "../h/initProc.h"
+#include "../h/vmSupport.h"
+#include "../h/delayDaemon.h"
+#include "/usr/include/umps3/umps/libumps.h"
+
+/* function declarations */
+HIDDEN void twInsert(int asid); /* function declaration for the function that places a sleeping U-proc in its slot of the timer wheel */
+
+/* declaring variables that are global to this module */
+HIDDEN int twSem; /* mutual exclusion semaphore over the timer wheel */
+HIDDEN int twNow; /* the number of Pseudo-clock ticks the delay daemon has seen */
+HIDDEN int twHead[TWLEVELS][TWSLOTS]; /* the ASID of the first sleeper in each slot of the wheel (NOUPROC if the slot is empty) */
+HIDDEN int twNext[UPROCMAX + 1]; /* the ASID of the sleeper after each sleeper in its slot (NOUPROC if it is the last) */
+HIDDEN int twWake[UPROCMAX + 1]; /* the tick at which each sleeper is due to be woken */
+HIDDEN int delaySem[UPROCMAX + 1]; /* the private semaphore on which each sleeping U-proc waits */
+
+/* Function that initializes the timer wheel. This function is called once by test() in initProc.c, before it launches the delay daemon. */
+void initDelayStructs(){
+	int i, j; /* loop variables */
+
+	twSem = 1; /* the timer wheel is not in use */
+	twNow = 0;
+	for (i = 0; i < TWLEVELS; i++){
+		for (j = 0; j < TWSLOTS; j++){
+			twHead[i][j] = NOUPROC;
+		}
+	}
+	for (i = 0; i < UPROCMAX + 1; i++){
+		twNext[i] = NOUPROC;
+		delaySem[i] = 0; /* synchronization semaphore */
+	}
+}
+
+/* Internal helper function that places the U-proc whose ASID is asid (whose wake-up tick is already in twWake) at the head of its slot of
+the timer wheel: the level 0 slot of its tick if it is due within TWSLOTS ticks, the level 1 slot of its span of TWSLOTS ticks if it is
+due within TWSLOTS * TWSLOTS ticks, or otherwise the last level 1 slot, from which it is placed again when that slot is reached. Note
+that the caller must hold mutual exclusion over the timer wheel. */
+void twInsert(int asid){
+	/* declaring local variables */
+	int level; /* the level of the wheel the sleeper is placed in */
+	int slot; /* the slot of that level the sleeper is placed in */
+
+	if (twWake[asid] - twNow < TWSLOTS){ /* if the sleeper is due within TWSLOTS ticks */
+		level = 0;
+		slot = twWake[asid] % TWSLOTS;
+	}
+	else if (twWake[asid] - twNow < TWSLOTS * TWSLOTS){ /* if the sleeper is due within the level 1 slots */
+		level = 1;
+		slot = (twWake[asid] / TWSLOTS) % TWSLOTS;
+	}
+	else{ /* the sleeper is due beyond the wheel */
+		level = 1;
+		slot = ((twNow / TWSLOTS) + TWSLOTS - 1) % TWSLOTS;
+	}
+	twNext[asid] = twHead[level][slot];
+	twHead[level][slot] = asid;
+}
+
+/* Function that suspends the U-proc whose ASID is asid for at least secs seconds. The function places the U-proc on the timer wheel and
+waits on the U-proc's private semaphore until the delay daemon wakes it. */
+void delayUProc(int asid, int secs){
+	if (secs <= 0){ /* if there is nothing to wait for */
+		return;
+	}
+	mutex(TRUE, (int *) &twSem); /* calling the function that gains mutual exclusion over the timer wheel */
+	twWake[asid] = twNow + (secs * TICKSPERSEC) + 1; /* the current tick has already partly elapsed, so the U-proc waits for one more */
+	twInsert(asid); /* calling the internal helper function to place the U-proc on the wheel */
+	mutex(FALSE, (int *) &twSem); /* calling the function that releases mutual exclusion over the timer wheel */
+	mutex(TRUE, (int *) &(delaySem[asid])); /* waiting for the delay daemon to wake the U-proc */
+}
+
+/* Function that implements the delay daemon, which advances the timer wheel once per Pseudo-clock tick. When the tick begins a new span of
+TWSLOTS ticks, the sleepers in that span's level 1 slot are placed again (which moves them to level 0); then every sleeper in the tick's
+level 0 slot, all of which are due at this tick, is woken. */
+void delayDaemon(){
+	/* declaring local variables */
+	int asid; /* the ASID of the sleeper being examined */
+	int next; /* the ASID of the sleeper after it in its slot */
+
+	while (TRUE){
+		SYSCALL(SYS7NUM, 0, 0, 0); /* waiting for the next Pseudo-clock tick */
+		mutex(TRUE, (int *) &twSem); /* calling the function that gains mutual exclusion over the timer wheel */
+		twNow++;
+		if ((twNow % TWSLOTS) == 0){ /* if the tick begins a new span, cascade the span's level 1 slot down to level 0 */
+			asid = twHead[1][(twNow / TWSLOTS) % TWSLOTS];
+			twHead[1][(twNow / TWSLOTS) % TWSLOTS] = NOUPROC;
+			while (asid != NOUPROC){
+				next = twNext[asid];
+				twInsert(asid); /* calling the internal helper function to place the sleeper again */
+				asid = next;
+			}
+		}
+
+		/* waking the sleepers due at this tick as a batch */
+		asid = twHead[0][twNow % TWSLOTS];
+		twHead[0][twNow % TWSLOTS] = NOUPROC;
+		while (asid != NOUPROC){
+			next = twNext[asid];
+			mutex(FALSE, (int *) &(delaySem[asid])); /* performing a V operation on the sleeper's private semaphore to wake it */
+			asid = next;
+		}
+		mutex(FALSE, (int *) &twSem); /* calling the function that releases mutual exclusion over the timer wheel */
+	}
+}
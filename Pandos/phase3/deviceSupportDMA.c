@@ -0,0 +1,466 @@
+/**************************************************************************** 
+ *
+ * This module implements the disk and flash I/O performed on behalf of the
+ * U-procs (i.e., SYS14 through SYS17 and SYS28, which sysSupport.c passes to
+ * diskOperation(), bcacheOperation() and bcacheFlush()). When the U-proc's
+ * buffer is page-aligned, its page is pinned into the Swap Pool and the
+ * device transfers the sector or block directly to or from the frame, so
+ * that no copy is made. Otherwise, a sector or block is transferred through
+ * the requesting U-proc's own DMA buffer, so that copying it to or from the
+ * U-proc's address space with copyIn() and copyOut() (which may cause page
+ * faults) happens while the device (or the block cache) serves other U-procs.
+ *
+ * Requests for a busy disk are not served in the order they arrive. Each
+ * waiting U-proc records the cylinder its sector lies on, and when the
+ * disk completes a request it is handed to the waiting U-proc chosen by
+ * a C-LOOK elevator: the one whose cylinder is nearest at or beyond the
+ * boom's current cylinder, or (once there are none) the one whose
+ * cylinder is lowest, so that the boom sweeps across the disk in a single
+ * direction. The module also remembers the cylinder each disk's boom is
+ * positioned over, so that a SEEKCYL command is only issued when a
+ * request lies on a different cylinder.
+ *
+ * Flash blocks are read and written through a block cache of BCACHECNT
+ * buffers, so that repeated reads of a hot block do not touch the device.
+ * When a block that is not cached is accessed, the least recently used
+ * buffer is reused, after writing its block back to flash if it is dirty.
+ * SYS17 only writes into the cache; dirty blocks reach flash when they are
+ * evicted, when the flush daemon runs once every BCFLUSHTICKS Pseudo-clock
+ * ticks, on SYS28 and when a U-proc terminates. The Pager's reads of a
+ * U-proc's flash device or of a mapped flash region are satisfied from the
+ * cache when it holds the block (see flashOperation() in vmSupport.c), and
+ * its writes discard the cache's copy, and the same holds for the U-procs'
+ * page-aligned transfers. The swap devices are never cached.
+ *  
+ * Written by: Kollen Gruizenga and Jake Heyser
+ ****************************************************************************/
+
+#include "../h/asl.h"
+#include "../h/pcb.h"
+#include "../h/scheduler.h"
+#include "../h/exceptions.h"
+#include "../h/interrupts.h"
+#include "../h/initial.h"
+#include "../h/types.h"
+#include "../h/const.h"
+#include "../h/initProc.h"
+#include "../h/vmSupport.h"
+#include "../h/deviceSupportDMA.h"
+#include "/usr/include/umps3/umps/libumps.h"
+
+/* function declarations */
+HIDDEN int diskCommand(int diskNo, memaddr data0, unsigned int command, int readOrWrite); /* function declaration for the function that issues a single command to a disk */
+HIDDEN void diskAcquire(int asid, int diskNo, int cyl); /* function declaration for the function that waits for the elevator to hand a disk to a U-proc */
+HIDDEN void diskRelease(int diskNo); /* function declaration for the function that hands a disk to the next U-proc chosen by the elevator */
+HIDDEN void copyPage(memaddr dest, memaddr src); /* function declaration for the function that copies a page between two kernel buffers */
+HIDDEN int bcacheFind(int devNo, int blockNo); /* function declaration for the function that finds a block in the cache */
+HIDDEN int bcacheWriteBack(int entry); /* function declaration for the function that writes a dirty buffer back to flash */
+HIDDEN int bcacheGet(int devNo, int blockNo, int readBlock, int *statusCode); /* function declaration for the function that places a block in the cache */
+
+/* declaring variables that are global to this module */
+HIDDEN int diskSchedSem; /* mutual exclusion semaphore over the disks' request queues */
+HIDDEN int diskBusy[DEVPERINT]; /* TRUE if a U-proc has been handed the disk */
+HIDDEN int diskCurCyl[DEVPERINT]; /* the cylinder each disk's boom is positioned over (NOCYL if unknown) */
+HIDDEN int diskReqDisk[UPROCMAX + 1]; /* the disk each U-proc is waiting for (NODISK if it is not waiting) */
+HIDDEN int diskReqCyl[UPROCMAX + 1]; /* the cylinder of the sector each waiting U-proc has requested */
+HIDDEN int diskReqSem[UPROCMAX + 1]; /* the private semaphore on which each waiting U-proc waits to be handed its disk */
+HIDDEN bcache_t bcacheTbl[BCACHECNT]; /* the flash block cache's table; entry i describes the buffer at BCACHEADDR + (i * PAGESIZE) */
+HIDDEN int bcacheSem; /* mutual exclusion semaphore over the block cache (held across the flash transfers it performs) */
+HIDDEN int bcacheClock; /* the number of block cache accesses so far, used to stamp each entry's last use */
+
+/* Function that initializes the disks' request queues and the flash block cache. This function is called once by test() in initProc.c. */
+void initDeviceStructs(){
+	int i; /* loop variable */
+
+	diskSchedSem = 1; /* the request queues are not in use */
+	bcacheSem = 1; /* the block cache is not in use */
+	bcacheClock = 0;
+	for (i = 0; i < BCACHECNT; i++){
+		bcacheTbl[i].valid = FALSE;
+		bcacheTbl[i].dirty = FALSE;
+		bcacheTbl[i].lastUse = 0;
+	}
+	for (i = 0; i < DEVPERINT; i++){
+		diskBusy[i] = FALSE;
+		diskCurCyl[i] = NOCYL; /* the boom's position is unknown until the first SEEKCYL */
+	}
+	for (i = 0; i < UPROCMAX + 1; i++){
+		diskReqDisk[i] = NODISK;
+		diskReqSem[i] = 0; /* synchronization semaphore */
+	}
+}
+
+/* Function that returns the number of sectors on disk diskNo, computed from the geometry in its DATA1 field (0 if the disk is not installed). */
+int diskSectorCnt(int diskNo){
+	/* declaring local variables */
+	devregarea_t *temp; /* device register area that we can use to read disk diskNo's geometry */
+	unsigned int geometry; /* the contents of the disk's DATA1 field */
+
+	temp = (devregarea_t *) RAMBASEADDR; /* initialization of temp */
+	geometry = temp->devreg[((DISKINT - OFFSET) * DEVPERINT) + diskNo].d_data1;
+	return (geometry >> MAXCYLSHIFT) * ((geometry >> MAXHEADSHIFT) & DISKGEOMASK) * (geometry & DISKGEOMASK);
+}
+
+/* Function that returns the number of blocks on flash device devNo, as given by its DATA1 field (0 if the device is not installed). */
+int flashBlockCnt(int devNo){
+	devregarea_t *temp; /* device register area that we can use to read flash device devNo's size */
+
+	temp = (devregarea_t *) RAMBASEADDR; /* initialization of temp */
+	return temp->devreg[((FLASHINT - OFFSET) * DEVPERINT) + devNo].d_data1;
+}
+
+/* Internal helper function that submits a request to write data0 into disk diskNo's DATA0 field and command into its COMMAND field to the
+disk's request queue in the Nucleus, and blocks the U-proc (via SYS5) until the command completes, disabling interrupts so that both steps
+happen atomically. The function returns the disk's status code. */
+int diskCommand(int diskNo, memaddr data0, unsigned int command, int readOrWrite){
+	/* declaring local variables */
+	devreq_t req; /* the request submitted to disk diskNo's request queue */
+	int statusCode; /* the status code returned by the disk */
+
+	req.r_data0 = data0;
+	req.r_command = command;
+	setInterrupts(FALSE); /* calling the function that disables interrupts in order to submit the request and issue the SYS 5 atomically */
+	reqSubmit(DISKINT, diskNo, &req); /* calling the Nucleus function that queues the request (issuing it if the disk is idle) */
+	statusCode = SYSCALL(SYS5NUM, LINE3, diskNo, readOrWrite); /* issuing the SYS 5 call to block the I/O requesting process until the operation completes */
+	setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+	return statusCode;
+}
+
+/* Internal helper function that returns once the U-proc whose ASID is asid has been handed disk diskNo. If the disk is busy, the U-proc
+records the cylinder cyl of the sector it has requested and waits on its private semaphore until diskRelease() chooses it. */
+void diskAcquire(int asid, int diskNo, int cyl){
+	mutex(TRUE, (int *) &diskSchedSem); /* calling the function that gains mutual exclusion over the request queues */
+	if (!diskBusy[diskNo]){ /* if the disk is idle, the U-proc takes it at once */
+		diskBusy[diskNo] = TRUE;
+		mutex(FALSE, (int *) &diskSchedSem); /* calling the function that releases mutual exclusion over the request queues */
+		return;
+	}
+	diskReqDisk[asid] = diskNo;
+	diskReqCyl[asid] = cyl;
+	mutex(FALSE, (int *) &diskSchedSem); /* calling the function that releases mutual exclusion over the request queues */
+	mutex(TRUE, (int *) &(diskReqSem[asid])); /* waiting for diskRelease() to hand the disk to the U-proc (the disk stays busy on its behalf) */
+}
+
+/* Internal helper function that hands disk diskNo to the waiting U-proc chosen by the C-LOOK elevator (i.e., the one whose cylinder is
+nearest at or beyond the boom's cylinder or, if there is none, the one whose cylinder is lowest), or marks the disk idle if no U-proc
+is waiting for it. */
+void diskRelease(int diskNo){
+	/* declaring local variables */
+	int next; /* the ASID of the waiting U-proc that the disk is handed to next (NOUPROC if none) */
+	int nextUp; /* TRUE if next's cylinder is at or beyond the boom's cylinder */
+	int up; /* TRUE if the cylinder of the U-proc being examined is at or beyond the boom's cylinder */
+	int i; /* loop variable */
+
+	mutex(TRUE, (int *) &diskSchedSem); /* calling the function that gains mutual exclusion over the request queues */
+	next = NOUPROC;
+	nextUp = FALSE;
+	for (i = 1; i < UPROCMAX + 1; i++){
+		if (diskReqDisk[i] == diskNo){ /* if U-proc i is waiting for the disk */
+			up = (diskReqCyl[i] >= diskCurCyl[diskNo]);
+			if ((next == NOUPROC) || (up && !nextUp) || ((up == nextUp) && (diskReqCyl[i] < diskReqCyl[next]))){ /* if U-proc i comes before next in the sweep */
+				next = i;
+				nextUp = up;
+			}
+		}
+	}
+
+	if (next == NOUPROC){ /* if no U-proc is waiting for the disk */
+		diskBusy[diskNo] = FALSE;
+	}
+	else{
+		diskReqDisk[next] = NODISK;
+		mutex(FALSE, (int *) &(diskReqSem[next])); /* handing the disk (which stays busy) to the chosen U-proc */
+	}
+	mutex(FALSE, (int *) &diskSchedSem); /* calling the function that releases mutual exclusion over the request queues */
+}
+
+/* Function that reads (if readOrWrite is READ) or writes (if readOrWrite is WRITE) sector sectNo of disk diskNo on behalf of the U-proc whose
+Support Structure is supportStruct, transferring the sector from or to the PAGESIZE bytes starting at virtAddr. The caller has checked that
+sectNo lies on the disk. If virtAddr is page-aligned, the page is pinned with pinDmaPage() and the disk transfers the sector directly to or
+from the frame holding it; otherwise (or if the disk may not store into the page), the sector is transferred through the U-proc's DMA
+buffer. The function waits for the elevator to hand it the disk, seeks the boom to the sector's cylinder (if it is not already there),
+performs the transfer and hands the disk on before unpinning the frame (or copying the sector out of the DMA buffer). The function
+returns the disk's status code if the operation succeeded, or the negative of the status code if it led to an error status. */
+int diskOperation(int readOrWrite, int diskNo, int sectNo, memaddr virtAddr, support_t *supportStruct){
+	/* declaring local variables */
+	devregarea_t *temp; /* device register area that we can use to read and write disk diskNo */
+	unsigned int geometry; /* the contents of the disk's DATA1 field */
+	int heads; /* the number of heads of the disk */
+	int sects; /* the number of sectors per track of the disk */
+	int cyl; /* the cylinder the sector lies on */
+	int head; /* the head (i.e., surface) the sector lies on */
+	int sect; /* the sector's number on its track */
+	int statusCode; /* the status code returned by the disk */
+	int frameNo; /* the pinned frame holding the page at virtAddr (NOFRAME if the sector is transferred through the DMA buffer) */
+	char *buf; /* the address the disk transfers the sector to or from (the pinned frame or the U-proc's DMA buffer) */
+
+	/* translating the linear sector number into the disk's geometry */
+	temp = (devregarea_t *) RAMBASEADDR; /* initialization of temp */
+	geometry = temp->devreg[((DISKINT - OFFSET) * DEVPERINT) + diskNo].d_data1;
+	heads = (geometry >> MAXHEADSHIFT) & DISKGEOMASK;
+	sects = geometry & DISKGEOMASK;
+	cyl = sectNo / (heads * sects);
+	head = (sectNo / sects) % heads;
+	sect = sectNo % sects;
+
+	frameNo = NOFRAME;
+	if ((virtAddr % PAGESIZE) == 0){ /* if the buffer is a whole page, the disk can transfer the sector to or from its frame directly */
+		frameNo = pinDmaPage(supportStruct, virtAddr, readOrWrite); /* calling the function in vmSupport.c that pins the page (before any lock is held, since it may cause page faults) */
+	}
+	if (frameNo != NOFRAME){
+		buf = (char *) (SWAPPOOLADDR + (frameNo * PAGESIZE));
+	}
+	else{
+		buf = (char *) DMABUF(supportStruct->sup_asid);
+		if (readOrWrite == WRITE){ /* copying the sector into the DMA buffer while interrupts are enabled, since bringing in its pages may cause page faults */
+			copyIn(supportStruct, buf, virtAddr, PAGESIZE); /* calling the function in vmSupport.c that copies the page (whose range the caller has validated) */
+		}
+	}
+
+	diskAcquire(supportStruct->sup_asid, diskNo, cyl); /* calling the internal helper function that waits for the elevator to hand the U-proc the disk */
+	statusCode = READY;
+	if (diskCurCyl[diskNo] != cyl){ /* if the boom is not already over the sector's cylinder */
+		statusCode = diskCommand(diskNo, (memaddr) buf, SEEKCYL | (cyl << DISKCYLSHIFT), readOrWrite); /* calling the internal helper function to move the boom */
+		diskCurCyl[diskNo] = NOCYL; /* until the seek is known to have succeeded, the boom's position is unknown */
+		if (statusCode == READY){
+			diskCurCyl[diskNo] = cyl;
+		}
+	}
+	if (statusCode == READY){ /* if the boom is over the sector's cylinder */
+		if (readOrWrite == READ){ /* the disk's DATA0 field is written with the starting address of the frame or DMA buffer */
+			statusCode = diskCommand(diskNo, (memaddr) buf, DISKREADBLK | (head << DISKHEADSHIFT) | (sect << DISKSECTSHIFT), READ); /* calling the internal helper function to read the sector */
+		}
+		else{
+			statusCode = diskCommand(diskNo, (memaddr) buf, DISKWRITEBLK | (head << DISKHEADSHIFT) | (sect << DISKSECTSHIFT), WRITE); /* calling the internal helper function to write the sector */
+		}
+	}
+	diskRelease(diskNo); /* calling the internal helper function that hands the disk to the next U-proc chosen by the elevator */
+
+	if (frameNo != NOFRAME){ /* if the sector was transferred directly, there is nothing to copy */
+		unpinDmaFrame(frameNo, readOrWrite); /* calling the function in vmSupport.c that releases the pin */
+	}
+	if (statusCode != READY){ /* if the operation led to an error status */
+		return statusCode * (-1);
+	}
+	if ((readOrWrite == READ) && (frameNo == NOFRAME)){ /* copying the sector out of the DMA buffer now that the disk is serving other U-procs */
+		copyOut(supportStruct, virtAddr, buf, PAGESIZE); /* calling the function in vmSupport.c that copies the page (whose range the caller has validated) */
+	}
+	return statusCode;
+}
+
+/* Internal helper function that copies the page starting at kernel address src to the page starting at kernel address dest, a word at a time. */
+void copyPage(memaddr dest, memaddr src){
+	int i; /* loop variable */
+
+	for (i = 0; i < PAGESIZE / WORDLEN; i++){
+		((int *) dest)[i] = ((int *) src)[i];
+	}
+}
+
+/* Internal helper function that returns the entry of the block cache that holds block blockNo of flash device devNo (NOBCENTRY if the
+block is not cached). Note that the caller must hold mutual exclusion over the block cache. */
+int bcacheFind(int devNo, int blockNo){
+	int i; /* loop variable */
+
+	for (i = 0; i < BCACHECNT; i++){
+		if ((bcacheTbl[i].valid == TRUE) && (bcacheTbl[i].devNo == devNo) && (bcacheTbl[i].blockNo == blockNo)){
+			return i;
+		}
+	}
+	return NOBCENTRY;
+}
+
+/* Internal helper function that writes the block held by entry of the block cache back to flash if it is dirty. The function returns
+READY, or the device's status code if the write led to an error status (in which case the block stays dirty). Note that the caller
+must hold mutual exclusion over the block cache. */
+int bcacheWriteBack(int entry){
+	/* declaring local variables */
+	int statusCode; /* the status code returned by the flash device */
+
+	if ((bcacheTbl[entry].valid == FALSE) || (bcacheTbl[entry].dirty == FALSE)){ /* if the buffer does not hold a modified block */
+		return READY;
+	}
+	statusCode = flashTransfer(WRITE, bcacheTbl[entry].devNo, BCACHEADDR + (entry * PAGESIZE), bcacheTbl[entry].blockNo); /* calling the function in vmSupport.c that writes the block */
+	if (statusCode == READY){
+		bcacheTbl[entry].dirty = FALSE;
+	}
+	return statusCode;
+}
+
+/* Internal helper function that returns the entry of the block cache that holds block blockNo of flash device devNo, placing the block
+in the least recently used buffer if it is not already cached. The buffer's previous block is written back first if it is dirty, and the
+block is only read from flash if readBlock is TRUE (i.e., if the caller will not overwrite the whole buffer). The function returns
+NOBCENTRY, with the device's status code in statusCode, if a write-back or read led to an error status. Note that the caller must hold
+mutual exclusion over the block cache. */
+int bcacheGet(int devNo, int blockNo, int readBlock, int *statusCode){
+	/* declaring local variables */
+	int entry; /* the entry that holds (or will hold) the block */
+	int i; /* loop variable */
+
+	*statusCode = READY;
+	bcacheClock++;
+	entry = bcacheFind(devNo, blockNo); /* calling the internal helper function to check whether the block is cached */
+	if (entry == NOBCENTRY){ /* if the block is not cached, reuse the least recently used buffer */
+		entry = 0;
+		for (i = 1; i < BCACHECNT; i++){
+			if ((bcacheTbl[entry].valid == TRUE) && ((bcacheTbl[i].valid == FALSE) || (bcacheTbl[i].lastUse < bcacheTbl[entry].lastUse))){
+				entry = i;
+			}
+		}
+		*statusCode = bcacheWriteBack(entry); /* calling the internal helper function to write the buffer's previous block back to flash */
+		if (*statusCode != READY){
+			return NOBCENTRY;
+		}
+		bcacheTbl[entry].valid = FALSE;
+		if (readBlock == TRUE){ /* if the block must be read from flash */
+			*statusCode = flashTransfer(READ, devNo, BCACHEADDR + (entry * PAGESIZE), blockNo); /* calling the function in vmSupport.c that reads the block */
+			if (*statusCode != READY){
+				return NOBCENTRY;
+			}
+		}
+		bcacheTbl[entry].valid = TRUE;
+		bcacheTbl[entry].devNo = devNo;
+		bcacheTbl[entry].blockNo = blockNo;
+		bcacheTbl[entry].dirty = FALSE;
+	}
+	bcacheTbl[entry].lastUse = bcacheClock;
+	return entry;
+}
+
+/* Function that reads (if readOrWrite is READ) or writes (if readOrWrite is WRITE) block blockNo of flash device devNo through the block
+cache on behalf of the U-proc whose Support Structure is supportStruct, transferring the block through the U-proc's DMA buffer from or to
+the PAGESIZE bytes starting at virtAddr. The caller has checked that the block lies on the device and that the device is not a swap device.
+A written block is only marked dirty in the cache. If virtAddr is page-aligned, however, the page is pinned with pinDmaPage() and the
+block bypasses the cache, as the Pager's transfers do: a read is copied from the cache if the cache holds the block and is otherwise read
+from flash directly into the frame, and a write discards the cache's copy and is written to flash directly from the frame. The function
+returns READY if the operation succeeded, or the negative of the flash device's status code if a read, write or write-back led to an
+error status. */
+int bcacheOperation(int readOrWrite, int devNo, int blockNo, memaddr virtAddr, support_t *supportStruct){
+	/* declaring local variables */
+	int entry; /* the block cache entry that holds the block */
+	int statusCode; /* the status code returned by the flash device */
+	int frameNo; /* the pinned frame holding the page at virtAddr (NOFRAME if the block goes through the cache) */
+	memaddr frameAddr; /* the starting address of the pinned frame */
+	char *buf; /* the U-proc's DMA buffer */
+
+	frameNo = NOFRAME;
+	if ((virtAddr % PAGESIZE) == 0){ /* if the buffer is a whole page, the device can transfer the block to or from its frame directly */
+		frameNo = pinDmaPage(supportStruct, virtAddr, readOrWrite); /* calling the function in vmSupport.c that pins the page (before the block cache is locked, since it may cause page faults) */
+	}
+	if (frameNo != NOFRAME){
+		frameAddr = SWAPPOOLADDR + (frameNo * PAGESIZE);
+		statusCode = READY;
+		mutex(TRUE, (int *) &bcacheSem); /* calling the function that gains mutual exclusion over the block cache, so that no stale copy of the block is cached meanwhile */
+		entry = bcacheFind(devNo, blockNo); /* calling the internal helper function to check whether the block is cached */
+		if ((readOrWrite == READ) && (entry != NOBCENTRY)){ /* if the cache holds the block, which may be newer than the block on flash */
+			bcacheClock++;
+			bcacheTbl[entry].lastUse = bcacheClock;
+			copyPage(frameAddr, BCACHEADDR + (entry * PAGESIZE)); /* calling the internal helper function to copy the block into the frame */
+		}
+		else{
+			if (entry != NOBCENTRY){ /* the cache's copy is older than the page being written */
+				bcacheTbl[entry].valid = FALSE;
+				bcacheTbl[entry].dirty = FALSE;
+			}
+			statusCode = flashTransfer(readOrWrite, devNo, frameAddr, blockNo); /* calling the function in vmSupport.c that transfers the block */
+		}
+		mutex(FALSE, (int *) &bcacheSem); /* calling the function that releases mutual exclusion over the block cache */
+		unpinDmaFrame(frameNo, readOrWrite); /* calling the function in vmSupport.c that releases the pin */
+		if (statusCode != READY){ /* if the operation led to an error status */
+			return statusCode * (-1);
+		}
+		return READY;
+	}
+
+	buf = (char *) DMABUF(supportStruct->sup_asid);
+	if (readOrWrite == WRITE){ /* copying the block into the DMA buffer while interrupts are enabled, since bringing in its pages may cause page faults */
+		copyIn(supportStruct, buf, virtAddr, PAGESIZE); /* calling the function in vmSupport.c that copies the page (whose range the caller has validated) */
+	}
+
+	mutex(TRUE, (int *) &bcacheSem); /* calling the function that gains mutual exclusion over the block cache */
+	entry = bcacheGet(devNo, blockNo, (readOrWrite == READ), &statusCode); /* calling the internal helper function to find (or place) the block in the cache */
+	if (entry != NOBCENTRY){
+		if (readOrWrite == READ){
+			copyPage((memaddr) buf, BCACHEADDR + (entry * PAGESIZE)); /* calling the internal helper function to copy the block into the DMA buffer */
+		}
+		else{
+			copyPage(BCACHEADDR + (entry * PAGESIZE), (memaddr) buf); /* calling the internal helper function to copy the block into the cache */
+			bcacheTbl[entry].dirty = TRUE;
+		}
+	}
+	mutex(FALSE, (int *) &bcacheSem); /* calling the function that releases mutual exclusion over the block cache */
+
+	if (entry == NOBCENTRY){ /* if the operation led to an error status */
+		return statusCode * (-1);
+	}
+	if (readOrWrite == READ){ /* copying the block out of the DMA buffer once the block cache is free for other U-procs */
+		copyOut(supportStruct, virtAddr, buf, PAGESIZE); /* calling the function in vmSupport.c that copies the page (whose range the caller has validated) */
+	}
+	return READY;
+}
+
+/* Function that copies block blockNo of flash device devNo into the frame starting at frameAddress if the block cache holds it. The
+function returns TRUE if it did, or FALSE if the caller must read the block from flash. It is called by the Pager (see flashOperation()
+in vmSupport.c), whose misses are not placed in the cache, since the Swap Pool already holds the pages it reads. */
+int bcacheLookup(int devNo, int blockNo, memaddr frameAddress){
+	/* declaring local variables */
+	int entry; /* the block cache entry that holds the block */
+
+	mutex(TRUE, (int *) &bcacheSem); /* calling the function that gains mutual exclusion over the block cache */
+	entry = bcacheFind(devNo, blockNo); /* calling the internal helper function to check whether the block is cached */
+	if (entry != NOBCENTRY){
+		bcacheClock++;
+		bcacheTbl[entry].lastUse = bcacheClock;
+		copyPage(frameAddress, BCACHEADDR + (entry * PAGESIZE)); /* calling the internal helper function to copy the block into the frame */
+	}
+	mutex(FALSE, (int *) &bcacheSem); /* calling the function that releases mutual exclusion over the block cache */
+	return (entry != NOBCENTRY);
+}
+
+/* Function that drops the block cache's copy of block blockNo of flash device devNo (even if it is dirty), because the Pager is about to
+write a newer copy of the block to flash. */
+void bcacheDiscard(int devNo, int blockNo){
+	/* declaring local variables */
+	int entry; /* the block cache entry that holds the block */
+
+	mutex(TRUE, (int *) &bcacheSem); /* calling the function that gains mutual exclusion over the block cache */
+	entry = bcacheFind(devNo, blockNo); /* calling the internal helper function to check whether the block is cached */
+	if (entry != NOBCENTRY){
+		bcacheTbl[entry].valid = FALSE;
+		bcacheTbl[entry].dirty = FALSE;
+	}
+	mutex(FALSE, (int *) &bcacheSem); /* calling the function that releases mutual exclusion over the block cache */
+}
+
+/* Function that writes every dirty block in the block cache back to flash. The function returns SUCCESSCONST, or the negative of the
+status code of the first write-back that led to an error status (the blocks whose write-back failed stay dirty). */
+int bcacheFlush(){
+	/* declaring local variables */
+	int result; /* the value returned to the caller */
+	int statusCode; /* the status code returned by the flash device */
+	int i; /* loop variable */
+
+	result = SUCCESSCONST;
+	mutex(TRUE, (int *) &bcacheSem); /* calling the function that gains mutual exclusion over the block cache */
+	for (i = 0; i < BCACHECNT; i++){
+		statusCode = bcacheWriteBack(i); /* calling the internal helper function to write the buffer's block back to flash (if it is dirty) */
+		if ((statusCode != READY) && (result == SUCCESSCONST)){
+			result = statusCode * (-1);
+		}
+	}
+	mutex(FALSE, (int *) &bcacheSem); /* calling the function that releases mutual exclusion over the block cache */
+	return result;
+}
+
+/* Function that implements the block cache's flush daemon, which writes the cache's dirty blocks back to flash once every BCFLUSHTICKS
+Pseudo-clock ticks, so that a block written by SYS17 does not stay only in RAM for long. */
+void bcacheFlushDaemon(){
+	int i; /* loop variable */
+
+	while (TRUE){
+		for (i = 0; i < BCFLUSHTICKS; i++){
+			SYSCALL(SYS7NUM, 0, 0, 0); /* waiting for the next Pseudo-clock tick */
+		}
+		bcacheFlush(); /* calling the function that writes the dirty blocks back to flash */
+	}
+}
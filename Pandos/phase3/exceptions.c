@@ -5,6 +5,16 @@
  * for TLB trap events-- tlbTrapH(), and for SYSCALL exception events-- sysTrapH()...in addition to all of the 
  * specific helper functions for various SYSCALL numbers. This module is also responsible for handling
  * Pass Up or Die events.
+ *
+ * The module also contains the TLB-Refill handler and the functions that
+ * keep the TLB consistent with the U-procs' Page Tables. Rather than erasing
+ * all of the entries in the TLB whenever a Page Table entry changes, the
+ * Pager invalidates only the cached copies of that entry, and the refill
+ * handler keeps a larger software TLB of recently refilled entries that it
+ * checks before walking the Page Table. Two TLB entries are loaded with the
+ * stack page and current .text page of each U-proc as it is dispatched. The
+ * number of refills and of software TLB hits are kept in tlbRefillCnt and
+ * stlbHitCnt, so that the size of the software TLB can be tuned.
  * 
  * While the General Exception Handler can directly call pgmTrapH(), tlbTrapH(), and sysTrapH(), 
  * most of the functions within this module pertain to SYSCALL exceptions, and thus the
@@ -48,10 +58,16 @@ HIDDEN void waitForIO(int lineNum, int deviceNum, int readBool);
 HIDDEN void getCPUTime();
 HIDDEN void waitForPClock();
 HIDDEN void getSupportData();
+HIDDEN pte_entry_t *walkPgTbl(support_t *supportStruct, unsigned int vpn);
+HIDDEN void loadWiredSlot(int slot, pte_entry_t *pte);
 
 /* declaring variables that are global to this module */
 int sysNum; /* the number of the SYSCALL that we are addressing */
 cpu_t curr_tod; /* variable to hold the current TOD clock value */
+int tlbRefillCnt; /* the number of TLB-Refill events handled (for tuning the size of the software TLB) */
+int stlbHitCnt; /* the number of TLB-Refill events satisfied by the software TLB */
+HIDDEN pte_entry_t swTlb[STLBSIZE]; /* the software TLB, holding copies (without their software-only bits) of recently refilled Page Table entries */
+HIDDEN pcb_PTR wiredProc; /* the process whose stack page was last loaded into the wired TLB entry */
 
 /* Function that copies the saved exception located at the start of the BIOS Data Page to the Current Process' pcb so that
 it contains the updated processor state after an exception (or interrupt) is handled */
@@ -332,21 +348,150 @@ void pgmTrapH(){
 }
 
 /* Function that handles TLB-Refill events. In other words, this function dictates what happens when a logical address translation's
-search of the TLB for a matching entry fails. This function inserts into the TLB the missing Page Table entry and returns control
-back to the Current Process to retry the instruction that caused the TLB-Refill event. */
+search of the TLB for a matching entry fails. This function translates the missing VPN into a logical page number, looks the page up
+in the Current Process' two-level Page Table, inserts the missing Page Table entry into the TLB and returns control back to the Current
+Process to retry the instruction that caused the TLB-Refill event. Since every access to a page that was just mapped by the Pager passes
+through this function, the function also turns on the entry's software reference bit, which the Pager uses to determine whether pages
+it read ahead were ever used. If the VPN lies outside the Current Process' address space, or the table that would hold its entry has not
+been allocated yet, the function inserts an invalid entry instead, so that the retried instruction raises a TLB-Invalid exception that
+is passed up to the Pager.
+
+Before walking the Page Table, the function checks the software TLB, which holds copies of the entries most recently inserted into the
+TLB; since the hardware TLB is small, most TLB-Refill events are for entries that it recently held. An entry is only placed in the
+software TLB after a Page Table walk (which turns its reference bit on), and tlbInvalidate() removes it whenever the Page Table entry
+changes, so a hit never needs to update the Page Table entry. */
 void uTLB_RefillHandler(){
 	/* declaring local variables */
 	state_PTR oldState; /* a pointer to the saved exception state at the start of the BIOS Data Page */
-	int missingPgNo; /* the page number of the missing TLB entry */
+	pte_entry_t *pte; /* a pointer to the missing Page Table entry */
+	int slot; /* the software TLB entry that may hold the missing entry */
 
 	/* initializing local variables */
 	oldState = (state_t *) BIOSDATAPAGE; /* initializing oldState to the saved exception state at the start of the BIOS Data Page */
-	missingPgNo = ((oldState->s_entryHI) & GETVPN) >> VPNSHIFT; /* initializing the missing page number to the VPN specified in the EntryHI field of the saved exception state */
-	missingPgNo = missingPgNo % ENTRIESPERPG; /* using the hash function to determine the page number of the missing TLB entry from the VPN calculated in the previous line */
+	slot = STLBHASH(oldState->s_entryHI); /* hashing the missing VPN and the Current Process' ASID */
+	tlbRefillCnt++;
+
+	if (swTlb[slot].entryHI == oldState->s_entryHI){ /* if the software TLB holds the missing entry */
+		stlbHitCnt++;
+		setENTRYHI(swTlb[slot].entryHI); /* writing EntryHI of the cached entry into the TLB */
+		setENTRYLO(swTlb[slot].entryLO); /* writing EntryLO of the cached entry into the TLB */
+		TLBWR(); /* finalizing the writing of the missing page table entry into the TLB */
+		LDST(oldState); /* returning control back to the Current Proccess to retry the instruction that caused the TLB-Refill event */
+	}
 
-	setENTRYHI(currentProc->p_supportStruct->sup_privatePgTbl[missingPgNo].entryHI); /* writing EntryHI of the missing page table entry into the TLB */
-	setENTRYLO(currentProc->p_supportStruct->sup_privatePgTbl[missingPgNo].entryLO); /* writing EntryLO of the missing page table entry into the TLB */
+	pte = walkPgTbl(currentProc->p_supportStruct, ((oldState->s_entryHI) & GETVPN) >> VPNSHIFT); /* looking up the missing entry in the Current Process' Page Table */
+	if (pte == (pte_entry_t *) NULL){ /* if there is no Page Table entry for the VPN */
+		setENTRYHI(oldState->s_entryHI); /* writing the missing VPN (and the Current Process' ASID) into the TLB */
+		setENTRYLO(ALLOFF); /* writing an invalid EntryLO into the TLB, so that the Pager handles the retried access */
+	}
+	else{
+		pte->entryLO |= PTEREFBITON; /* recording that the missing page table entry has been referenced */
+		swTlb[slot].entryHI = pte->entryHI; /* caching the entry in the software TLB */
+		swTlb[slot].entryLO = (pte->entryLO) & PTEHWBITS;
+		setENTRYHI(pte->entryHI); /* writing EntryHI of the missing page table entry into the TLB */
+		setENTRYLO((pte->entryLO) & PTEHWBITS); /* writing EntryLO of the missing page table entry (without its software-only bits) into the TLB */
+	}
 
 	TLBWR(); /* finalizing the writing of the missing page table entry into the TLB */
 	LDST(oldState); /* returning control back to the Current Proccess to retry the instruction that caused the TLB-Refill event */
 }
+
+/* Function that returns a pointer to the Page Table entry for VPN vpn in the two-level Page Table of the U-proc whose Support Structure
+is supportStruct, or NULL if the VPN lies outside the U-proc's address space or the table that would hold its entry has not been
+allocated yet. */
+pte_entry_t *walkPgTbl(support_t *supportStruct, unsigned int vpn){
+	int pgNo; /* the logical page number of the VPN */
+	pte_entry_t *pgTbl; /* a pointer to the table of Page Table entries that holds the entry */
+
+	pgNo = VPNTOPGNO(vpn); /* translating the VPN into a logical page number */
+	if (pgNo == NOPAGE){ /* if the VPN lies outside the U-proc's address space */
+		return (pte_entry_t *) NULL;
+	}
+	pgTbl = supportStruct->sup_pgDir[pgNo / ENTRIESPERPG]; /* looking up the table that holds the entry in the page directory */
+	if (pgTbl == (pte_entry_t *) NULL){ /* if the table has not been allocated yet */
+		return (pte_entry_t *) NULL;
+	}
+	return &(pgTbl[pgNo % ENTRIESPERPG]);
+}
+
+/* Function that removes every cached copy of the Page Table entry pointed to by pte (from the software TLB and from the TLB, including
+its wired entries), so that the next access to the page uses the updated entry. It replaces erasing all of the entries in the TLB
+whenever a single Page Table entry changes. If the wired entry is erased, it is reloaded the next time its U-proc is dispatched,
+rather than being left empty. Note that the caller must have disabled interrupts. */
+void tlbInvalidate(pte_entry_t *pte){
+	/* declaring local variables */
+	unsigned int entryHI; /* the contents of the EntryHI register on entry, which the probe overwrites */
+	int slot; /* the software TLB entry that may hold the entry */
+
+	if ((pte->entryHI) < KUSEG){ /* if the entry is not the entry of a KUSEG page (e.g., it is owned by a shared memory segment), it is never in the TLB */
+		return;
+	}
+	slot = STLBHASH(pte->entryHI);
+	if (swTlb[slot].entryHI == pte->entryHI){ /* if the software TLB holds the entry */
+		swTlb[slot].entryHI = STLBNOENTRY;
+	}
+
+	entryHI = getENTRYHI(); /* saving the EntryHI register, which holds the current ASID */
+	setENTRYHI(pte->entryHI);
+	TLBP(); /* probing the TLB for an entry matching the page */
+	while (((getINDEX()) & TLBPROBEFAIL) == ALLOFF){ /* while a TLB entry matches the page */
+		if (((getINDEX()) >> TLBINDEXSHIFT) < TLBWIREDCNT){ /* if the matching entry is a wired entry */
+			wiredProc = NULL; /* forcing loadWiredTlb() to reload the wired entry from the updated Page Table */
+		}
+		setENTRYHI(STLBNOENTRY); /* overwriting the matching TLB entry with an invalid entry for VPN 0, which is never probed */
+		setENTRYLO(ALLOFF);
+		TLBWI();
+		setENTRYHI(pte->entryHI);
+		TLBP(); /* probing again, in case the page was also loaded into a wired entry */
+	}
+	setENTRYHI(entryHI); /* restoring the EntryHI register */
+}
+
+/* Function that empties the software TLB and erases all of the entries in the TLB. It is used when a U-proc terminates, so that no
+cached entry for its ASID survives. Note that the caller must have disabled interrupts. */
+void tlbFlush(){
+	int i;
+
+	for (i = 0; i < STLBSIZE; i++){
+		swTlb[i].entryHI = STLBNOENTRY;
+	}
+	TLBCLR(); /* erasing all of the entries in the TLB */
+	for (i = 0; i < TLBWIREDCNT; i++){
+		loadWiredSlot(i, (pte_entry_t *) NULL); /* erasing the wired entries as well */
+	}
+	wiredProc = NULL; /* the wired entry no longer holds any process' page */
+}
+
+/* Function that writes the Page Table entry pointed to by pte into wired TLB entry slot, or an invalid entry for VPN 0 if pte is NULL or
+the entry is not valid. */
+void loadWiredSlot(int slot, pte_entry_t *pte){
+	setINDEX(slot << TLBINDEXSHIFT); /* selecting the wired TLB entry */
+	if ((pte != (pte_entry_t *) NULL) && (((pte->entryLO) & VBITON) != ALLOFF)){ /* if the page is resident */
+		setENTRYHI(pte->entryHI);
+		setENTRYLO((pte->entryLO) & PTEHWBITS);
+	}
+	else{
+		setENTRYHI(STLBNOENTRY);
+		setENTRYLO(ALLOFF);
+	}
+	TLBWI(); /* writing the wired TLB entry */
+}
+
+/* Function that is called whenever a process is about to be dispatched. If the process is a U-proc other than the one whose page the
+wired TLB entry currently holds (or tlbInvalidate() or tlbFlush() has erased it since it was loaded), the function loads the wired TLB
+entry with its stack page, so that the U-proc does not take a TLB-Refill event on it after it has been switched out. Only entry 0 is
+wired, since it is the only entry that the Random register (and hence TLBWR in the TLB-Refill event handler) never selects. The
+function leaves EntryHI as it found it, since the processor state being loaded restores it. Note that interrupts are disabled, since
+the function runs in the nucleus. */
+void loadWiredTlb(pcb_PTR proc){
+	/* declaring local variables */
+	unsigned int entryHI; /* the contents of the EntryHI register on entry */
+
+	if ((proc == wiredProc) || (proc->p_supportStruct == NULL)){ /* if the wired entry already holds the process' stack page, or the process has no address space of its own */
+		return;
+	}
+	entryHI = getENTRYHI();
+	loadWiredSlot(WIREDSTACKSLOT, walkPgTbl(proc->p_supportStruct, STACKPGVPN)); /* loading the U-proc's stack page */
+	setENTRYHI(entryHI);
+	wiredProc = proc;
+}
@@ -1,14 +1,21 @@
 /**************************************************************************** 
  *
  * This module is responsible for implementing the test() function, declaring 
- * and initializing the phase 3 global variables, which include an array of
- * device semaphores and the masterSemaphore responsible for ensuring test()
- * comes to a more graceful conclusion by calling HALT() instead of PANIC().
+ * and initializing the phase 3 global variables, which include the
+ * masterSemaphore responsible for ensuring test() comes to a more graceful
+ * conclusion by calling HALT() instead of PANIC(). (The devices need no
+ * semaphores at this level, since the Nucleus queues the requests for each
+ * disk and flash device and each printer and terminal has only one user.)
  * In slightly greater detail, the module initializes the processor state
  * for the instantiator process "test," initializes the Support Structure
- * for the U-proc, and launches UPROCMAX processes. This module (via test())
+ * for the U-proc, and launches UPROCMAX processes, along with the support
+ * level daemon processes used by the Pager. This module (via test())
  * also invokes the function in vmSupport.c that is responsible for initializing
- * virtual memory (i.e., the Swap Pool table and the accompanying semaphore).
+ * virtual memory (i.e., the Swap Pool table and the accompanying semaphore),
+ * and the function in deviceSupportDMA.c that initializes the disks' request
+ * queues and the flash block cache, whose flush daemon test() also launches,
+ * as well as the delay daemon in delayDaemon.c. It also initializes the
+ * support level's ASL for virtual semaphores (in vsemSupport.c).
  *  
  * Written by: Kollen Gruizenga and Jake Heyser
  ****************************************************************************/
@@ -23,17 +30,17 @@
 #include "../h/initial.h"
 #include "../h/vmSupport.h"
 #include "../h/sysSupport.h"
+#include "../h/deviceSupportDMA.h"
+#include "../h/delayDaemon.h"
+#include "../h/vsemSupport.h"
 #include "/usr/include/umps3/umps/libumps.h"
 
 /* function declarations */
 HIDDEN void initProcessorState(state_PTR newState); /* function declaration for the function that is responsible for initializing the processor state for a U-proc */
+HIDDEN void launchDaemon(memaddr daemonPC, int *daemonStack); /* function declaration for the function that is responsible for launching a support level daemon process */
 
 /* declaring the phase 3 global variables */
 int masterSemaphore; /* semaphore to be V'd and P'd by test as a means to ensure test terminates in a way so that the PANIC() function is not called */
-int devSemaphores[MAXIODEVICES]; /* array of mutual exclusion semaphores; each potentially sharable peripheral I/O device has one
-									semaphore defined for it. Note that this array will be implemented so that terminal device semaphores
-									are last and terminal device semaphores	associated with a read operation in the array come before those
-									associated with a write operation. */
 
 /* Function that initializes the processor state (which is passed into the function as a parameter) for a U-proc. This function sets the address of the
 state's PC (and t9 register) to 0x8000.00B0, which is the address of the start of the .text section, sets the SP to 0xC000.0000, and sets the Status register
@@ -44,9 +51,30 @@ void initProcessorState(state_PTR newState){
 	newState->s_status = ALLOFF | USERPON | IEPON | PLTON | IMON; /* initializing the U-procs' status register so that interrupts are enabled, user-mode is on and the PLT is enabled */
 }
 
+/* Function that launches a support level daemon process whose code begins at the address daemonPC and whose stack area is the
+DAEMONSTACKSIZE-word array daemonStack. A daemon executes in kernel-mode with all interrupts and the processor Local Timer enabled,
+and it is launched without a Support Structure, since it never takes a page fault. As a child of test(), every daemon is terminated
+along with test() once all of the U-procs have concluded. */
+void launchDaemon(memaddr daemonPC, int *daemonStack){
+	/* declaring local variables */
+	state_t daemonState; /* the processor state for the daemon process */
+	int returnCode; /* the value that is returned from SYS1 when launching the daemon */
+
+	daemonState.s_entryHI = ALLOFF; /* daemons execute with ASID 0, since they only access kernel addresses */
+	daemonState.s_pc = daemonState.s_t9 = daemonPC; /* initializing the daemon's PC (and the contents of its t9 register) to the start of its code */
+	daemonState.s_sp = (memaddr) &(daemonStack[TOPOFSTACK]); /* initializing the daemon's stack pointer to the top of its stack area */
+	daemonState.s_status = ALLOFF | IEPON | PLTON | IMON; /* enabling interrupts, setting kernel-mode to on and enabling PLT */
+
+	returnCode = SYSCALL(SYS1NUM, (unsigned int) &daemonState, (unsigned int) NULL, 0); /* issuing the SYS 1 to launch the daemon */
+
+	if (returnCode != SUCCESSCONST){ /* if the daemon was not launched successfully */
+		SYSCALL(SYS2NUM, 0, 0, 0); /* terminate the process */
+	}
+}
+
 /* Function that represents the instantiator process. The function initializes the Phase 3 global variables, calls the function in 
-vmSupport.c that initializes virtual memory (including the Swap Pool table and the Swap Pool semaphore), initializes the processor state
-for the U-proc, initializes the Support Structure for the U-proc, launches UPROCMAX processes, and terminates after all of its U-proc
+vmSupport.c that initializes virtual memory (including the Swap Pool table and the Swap Pool semaphore), launches the Pager's
+read-ahead, page cleaner and Pseudo-clock daemons the flash block cache's flush daemon and the delay daemon, initializes the processor state for the U-proc, (optionally) preloads each U-proc's load image, initializes the Support Structure for the U-proc, launches UPROCMAX processes, and terminates after all of its U-proc
 "children" processes conclude */
 void test(){
 	/* declaring local variables */
@@ -54,15 +82,22 @@ void test(){
 	static support_t supportStructArr[UPROCMAX + 1]; /* static array of UPROCMAX + 1 Support Strucures that will allow one to obtain the
 													address of the next unused Support Structure that needs to be initialized */
 	int returnCode; /* the value that is returned from SYS1 when launching a new U-proc */
+	static int readAheadStack[DAEMONSTACKSIZE]; /* the stack area for the Pager's read-ahead daemon */
+	static int cleanerStack[DAEMONSTACKSIZE]; /* the stack area for the Pager's page cleaner daemon */
+	static int pseudoClockStack[DAEMONSTACKSIZE]; /* the stack area for the daemon that wakes the page cleaner on every Pseudo-clock tick */
+	static int bcacheFlushStack[DAEMONSTACKSIZE]; /* the stack area for the flash block cache's flush daemon */
+	static int delayStack[DAEMONSTACKSIZE]; /* the stack area for the delay daemon */
 	state_t initialState; /* the processor state for a U-proc, which will be initialized in this module */
 
-	/* initializing the I/O device semaphores to 1, since they will be used for the purpose of mutual exclusion */
-	int i;
-	for (i = 0; i < MAXIODEVICES; i++){
-		devSemaphores[i] = 1; 
-	}
-	
 	initSwapStructs(); /* calling the function in the vmSupport.c module that initializes virtual memory */
+	initDeviceStructs(); /* calling the function in the deviceSupportDMA.c module that initializes the disks' request queues and the flash block cache */
+	initDelayStructs(); /* calling the function in the delayDaemon.c module that initializes the timer wheel */
+	initVsemStructs(); /* calling the function in the vsemSupport.c module that initializes the support level's ASL */
+	launchDaemon((memaddr) readAheadDaemon, readAheadStack); /* launching the daemon that performs the Pager's read-ahead */
+	launchDaemon((memaddr) pageCleanerDaemon, cleanerStack); /* launching the daemon that writes dirty frames back to flash ahead of the Pager */
+	launchDaemon((memaddr) pseudoClockDaemon, pseudoClockStack); /* launching the daemon that wakes the page cleaner on every Pseudo-clock tick */
+	launchDaemon((memaddr) bcacheFlushDaemon, bcacheFlushStack); /* launching the daemon that writes the flash block cache's dirty blocks back to flash */
+	launchDaemon((memaddr) delayDaemon, delayStack); /* launching the daemon that wakes the U-procs sleeping in SYS18 */
 	initProcessorState(&initialState); /* calling the internal function that initializes the processor state of a given U-proc */
 
 	/* initializing UPROCMAX U-procs */
@@ -82,15 +117,17 @@ void test(){
 		supportStructArr[pid].sup_exceptContext[GENERALEXCEPT].c_stackPtr = (unsigned int) &(supportStructArr[pid].sup_stackGen[TOPOFSTACK]); /* setting the SP field for handling non-page fault exceptions to the address
 																																of the top of the stack reserved for handling such exceptions */																												
 		supportStructArr[pid].sup_asid = pid; /* initializing the U-proc's ASID */
+		supportStructArr[pid].sup_stackPgCnt = 1; /* the U-proc starts out with a single stack page */
+		supportStructArr[pid].sup_stackLimit = STACKLIMITINIT; /* initializing the largest number of pages the U-proc's stack may grow to */
+		supportStructArr[pid].sup_textPgCnt = 0; /* no page is known to hold only .text until the Pager reads the aout header */
+		supportStructArr[pid].sup_imageId = NOIMAGE; /* the U-proc's load image is identified once the Pager reads the aout header */
+		supportStructArr[pid].sup_imagePgCnt = IMAGEUNKNOWN; /* the bounds of the U-proc's load image are unknown until the Pager reads its aout header */
 
-		/* initializing the Page Table for the U-proc */
-		int j;
-		for (j = 0; j < ENTRIESPERPG; j++){
-			supportStructArr[pid].sup_privatePgTbl[j].entryHI = ALLOFF | ((VPNSTART + j) << VPNSHIFT) | (pid << ASIDSHIFT); /* initializing the EntryHI fields in the U-proc's Page Table */
-			supportStructArr[pid].sup_privatePgTbl[j].entryLO = ALLOFF | DBITON; /* initializing the EntryLo fields in the U-proc's Page Table so that the G and V bits are off and the D bit is on */
-		}
+		initPageTable(&(supportStructArr[pid])); /* calling the function in vmSupport.c that initializes the U-proc's page directory and its first table of Page Table entries */
 
-		supportStructArr[pid].sup_privatePgTbl[ENTRIESPERPG - 1].entryHI = ALLOFF | (STACKPGVPN << VPNSHIFT) | (pid << ASIDSHIFT); /* (re)initializing the stack page's EntryHI fields in the U-proc's Page Table */
+		if (PRELOADUPROCS == TRUE){ /* if U-procs are to be launched with their load image already in the Swap Pool */
+			preloadUProc(&(supportStructArr[pid])); /* calling the function in vmSupport.c that reads the U-proc's .text and .data pages and validates their Page Table entries */
+		}
 
 		returnCode = SYSCALL(SYS1NUM, (unsigned int) (&initialState), (unsigned int) &(supportStructArr[pid]), 0); /* issuing the SYS 1 to launch the new U-proc and assigning the function's return value to returnCode */
 
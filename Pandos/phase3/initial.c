@@ -98,6 +98,12 @@ int main(){
 	and the pcbFree list */
 	initPcbs(); /* initializing the pcbFree list */
 	initASL(); /* initializing the semdFree list and the ASL's dummy nodes */
+	tlbRefillCnt = 0; /* no TLB-Refill events have been handled yet */
+	stlbHitCnt = 0;
+	tlbFlush(); /* emptying the software TLB and the TLB (including its wired entries) */
+	outInit(); /* emptying the printers' spools and the terminals' transmit rings */
+	inInit(); /* emptying the terminals' input rings and starting each terminal's receiver */
+	reqInit(); /* emptying the disks' and flash devices' request queues */
 
 	/* initializing the Processor 0 Pass Up Vector */
 	procVec = (passupvector_t *) PASSUPVECTOR; /* initializing procVec to be a pointer to the address of the Process 0 Pass Up Vector */
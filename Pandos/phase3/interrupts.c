@@ -31,6 +31,28 @@
  * Current Process with this time, as it just so happened to be the process that was
  * executing when the System-wide Interval Timer reached zero. But, in general, the
  * time spent in this module will charged to the responsible process. 
+ *
+ * This module also owns an output ring for each printer (its spool) and for each
+ * terminal's transmitter. outEnqueue() copies a string into a ring and starts the
+ * device if it is idle; from then on, each completion interrupt is handled by issuing
+ * the next character in the ring directly from IOInt(), so that a writer only blocks
+ * (on the device's semaphore) when the ring is full or when it waits for the ring to
+ * drain. The first error status returned by a device is kept until it is collected
+ * with outTakeError(), and the rest of that device's ring is discarded.
+ *
+ * Likewise, each terminal's receiver is kept busy receiving into an input ring, so
+ * that characters typed while no U-proc is reading are not lost. IOInt() applies the
+ * line discipline as each character arrives (a backspace removes the last character
+ * of the line being typed) and only wakes a reader blocked in inWait() once a whole
+ * line (or an error) is available, which inDequeue() then hands over in one go.
+ *
+ * Finally, each disk and flash device has a request queue. reqSubmit() appends a
+ * request (a command and the value of its DATA0 field) to the device's queue,
+ * issuing it at once if the device is idle, and the caller then blocks on the
+ * device's semaphore with SYS5. When the device completes a request, IOInt()
+ * issues the next one in the queue before waking the process that submitted the
+ * completed one, so that the device is never idle while work is waiting for it
+ * and no mutual exclusion is needed over the device's device register.
  * 
  * 
  * Written by: Kollen Gruizenga and Jake Heyser
@@ -51,10 +73,35 @@ HIDDEN void pltTimerInt();
 HIDDEN void intTimerInt();
 HIDDEN void IOInt();
 HIDDEN int findDeviceNum(int lineNumber);
+HIDDEN void outStart(int ring); /* issues the first character in an output ring to its device */
+HIDDEN int outputInt(int ring, int statusCode); /* issues the next character in an output ring after a printer or terminal transmit-completion interrupt */
+HIDDEN void inStart(int devNo); /* issues a receive command to a terminal whose input ring has room */
+HIDDEN int inReady(int devNo); /* determines whether a reader of a terminal's input ring may proceed */
+HIDDEN int inputInt(int devNum, int statusCode); /* places a received character in a terminal's input ring after a receive-completion interrupt */
+HIDDEN void reqStart(int lineNum, int devNo); /* issues the first request in a disk's or flash device's request queue */
+HIDDEN void reqNext(int lineNum, int devNo); /* removes a completed request from its device's queue and issues the next one */
 
 /* Declaring variables that are global to this module */
 cpu_t interrupt_tod; /* the value on the Time of Day clock when the Interrupt Handler module is first entered */
 cpu_t remaining_time; /* the amount of time left on the Current Process' quantum when the interrupt was generated */
+HIDDEN char prntSpool[DEVPERINT][PRNTSPOOLSIZE]; /* each printer's spool, holding the characters that have not yet been printed */
+HIDDEN char termRing[DEVPERINT][TERMRINGSIZE]; /* each terminal's transmit ring, holding the characters that have not yet been transmitted */
+HIDDEN char *outBuf[OUTRINGCNT]; /* the storage of each output ring (a printer's spool or a terminal's transmit ring) */
+HIDDEN int outSize[OUTRINGCNT]; /* the number of characters each output ring can hold */
+HIDDEN int outHead[OUTRINGCNT]; /* the index in outBuf of the next character each device outputs */
+HIDDEN int outCnt[OUTRINGCNT]; /* the number of characters in each output ring */
+HIDDEN int outBusy[OUTRINGCNT]; /* TRUE if a character is being output by the device */
+HIDDEN int outWaiting[OUTRINGCNT]; /* TRUE if a writer is blocked on the device's semaphore, waiting for its ring to drain */
+HIDDEN int outError[OUTRINGCNT]; /* the first error status returned by the device that has not yet been collected (NOOUTERR if none) */
+HIDDEN char inRing[DEVPERINT][TERMINSIZE]; /* each terminal's input ring, holding the characters received but not yet read */
+HIDDEN int inHead[DEVPERINT]; /* the index in inRing of the next character to be read from each terminal */
+HIDDEN int inCnt[DEVPERINT]; /* the number of characters in each terminal's input ring */
+HIDDEN int inLineCnt[DEVPERINT]; /* the number of complete lines (i.e., newlines) in each terminal's input ring */
+HIDDEN int inBusy[DEVPERINT]; /* TRUE if the terminal's receiver has been issued a receive command */
+HIDDEN int inWaiting[DEVPERINT]; /* TRUE if a reader is blocked on the terminal's receive semaphore, waiting for a line */
+HIDDEN int inError[DEVPERINT]; /* the first error status returned by the terminal's receiver that has not yet been collected (NOOUTERR if none) */
+HIDDEN devreq_t *reqHead[REQQCNT]; /* the request each disk and flash device is performing (NULL if the device is idle) */
+HIDDEN devreq_t *reqTail[REQQCNT]; /* the last request in each disk's and flash device's request queue */
 
 /* Internal helper function responsible for determining what device number the highest-priority interrupt occurred on. The function
 returns that number to the caller. */
@@ -153,7 +200,11 @@ saves off the status code from the device's device register, acknowledges the ou
 device's device register, and peforms a V operation on the Nucleus maintained semaphore associated with this device. Then, it places the stored off status code
 in the newly unblocked pcb's v0 register, inserts the newly unblobked pcb on the Ready Queue, and then updates the CPU time of the Current Process so that it
 includes the time that it spent executing up until when the interrupt first occurred, and then it charges the time spent handling the interrupt to the 
-process responsible for generating the I/O interrupt (if it is not NULL), as described in the module-level documentation for this module. */
+process responsible for generating the I/O interrupt (if it is not NULL), as described in the module-level documentation for this module. A printer
+or terminal transmit interrupt is instead passed to outputInt(), which issues the next character in the device's output ring, and the V operation is
+only performed when a writer waiting for the ring to drain can make progress. Similarly, a terminal receive interrupt is passed to inputInt(), and
+the V operation is only performed once a reader can take a whole line. A disk or flash interrupt is passed to reqNext(), which issues the next
+request in the device's queue before the process that submitted the completed request is unblocked. */
 void IOInt(){
 	/* declaring local variables */
 	cpu_t curr_tod; /* variable to hold the current TOD clock value */
@@ -186,16 +237,40 @@ void IOInt(){
 	index = ((lineNum - OFFSET) * DEVPERINT) + devNum; /* initializing the index in deviceSemaphores of the device associated with the highest-priority interrupt */
 	temp = (devregarea_t *) RAMBASEADDR; /* initialization of temp */
 	
-	if ((lineNum == LINE7) && (((temp->devreg[index].t_transm_status) & STATUSON) != READY)){ /* if the highest-priority interrupt occurred on line 7 and if the device's status code is not 1, meaning the device is not "Ready" */
+	if ((lineNum == LINE7) && (((temp->devreg[index].t_transm_status) & STATUSON) != READY) && (((temp->devreg[index].t_transm_status) & STATUSON) != BUSY)){ /* if the highest-priority interrupt occurred on line 7 and if the transmitter's status code is neither 1 nor 3, meaning the transmitter has completed a character (rather than being idle or still transmitting) */
 		/* the interrupt is associated with a terminal device and is a write interrupt */
 		statusCode = temp->devreg[index].t_transm_status; /* initializing the status code from the device register associated with the device that corresponds to the highest-priority interrupt */
 		temp->devreg[index].t_transm_command = ACK; /* acknowledging the outstanding interrupt by writing the acknowledge command code in the interrupting device's device register */
-		unblockedPcb = removeBlocked(&deviceSemaphores[index + DEVPERINT]); /* initializing unblockedPcb by unblocking the semaphore associated with the interrupt and returning the corresponding pcb */
-		deviceSemaphores[index + DEVPERINT]++; /* incrementing the value of the semaphore associated with the interrupt as part of the V operation */
+		unblockedPcb = NULL; /* the writer stays blocked (or is not blocked at all) until its ring drains */
+		if (outputInt(OUTRING(LINE7, devNum), statusCode)){ /* calling the internal function that feeds the terminal the next character in its transmit ring */
+			unblockedPcb = removeBlocked(&deviceSemaphores[index + DEVPERINT]); /* initializing unblockedPcb by unblocking the semaphore associated with the interrupt and returning the corresponding pcb */
+			deviceSemaphores[index + DEVPERINT]++; /* incrementing the value of the semaphore associated with the interrupt as part of the V operation */
+		}
+	}
+	else if (lineNum == LINE6){ /* if the highest-priority interrupt occurred on a printer, which only prints characters from its spool */
+		statusCode = temp->devreg[index].d_status; /* initializing the status code from the device register associated with the device that corresponds to the highest-priority interrupt */
+		temp->devreg[index].d_command = ACK; /* acknowledging the outstanding interrupt by writing the acknowledge command code in the interrupting device's device register */
+		unblockedPcb = NULL; /* the writer stays blocked (or is not blocked at all) until its spool drains */
+		if (outputInt(OUTRING(LINE6, devNum), statusCode)){ /* calling the internal function that feeds the printer the next character in its spool */
+			unblockedPcb = removeBlocked(&deviceSemaphores[index]); /* initializing unblockedPcb by unblocking the semaphore associated with the interrupt and returning the corresponding pcb */
+			deviceSemaphores[index]++; /* incrementing the value of the semaphore associated with the interrupt as part of the V operation */
+		}
+	}
+	else if (lineNum == LINE7){ /* if the highest-priority interrupt was a read interrupt on a terminal device, whose receiver only receives into its input ring */
+		statusCode = temp->devreg[index].t_recv_status; /* initializing the status code from the device register associated with the device that corresponds to the highest-priority interrupt */
+		temp->devreg[index].t_recv_command = ACK; /* acknowledging the outstanding interrupt by writing the acknowledge command code in the interrupting device's device register */
+		unblockedPcb = NULL; /* the reader stays blocked (or is not blocked at all) until a whole line has been received */
+		if (inputInt(devNum, statusCode)){ /* calling the internal function that places the received character in the terminal's input ring */
+			unblockedPcb = removeBlocked(&deviceSemaphores[index]); /* initializing unblockedPcb by unblocking the semaphore associated with the interrupt and returning the corresponding pcb */
+			deviceSemaphores[index]++; /* incrementing the value of the semaphore associated with the interrupt as part of the V operation */
+		}
 	}
-	else{ /* otherwise, the highest-priority interrupt either did not occur on a terminal device or it was a read interrupt on a terminal device */
+	else{ /* otherwise, the highest-priority interrupt did not occur on a printer or terminal device */
 		statusCode = temp->devreg[index].t_recv_status; /* initializing the status code from the device register associated with the device that corresponds to the highest-priority interrupt */
 		temp->devreg[index].t_recv_command = ACK; /* acknowledging the outstanding interrupt by writing the acknowledge command code in the interrupting device's device register */
+		if (lineNum <= LINE4){ /* if the interrupt occurred on a disk or flash device, whose commands are issued from its request queue */
+			reqNext(lineNum, devNum); /* calling the internal function that issues the next request in the device's queue */
+		}
 		unblockedPcb = removeBlocked(&deviceSemaphores[index]); /* initializing unblockedPcb by unblocking the semaphore associated with the interrupt and returning the corresponding pcb */
 		deviceSemaphores[index]++; /* incrementing the value of the semaphore associated with the interrupt as part of the V operation */
 	}
@@ -225,6 +300,325 @@ void IOInt(){
 	switchProcess(); /*calling the Scheduler to begin execution of the next process on the Ready Queue (if there is no Current Process to return control to) */
 }
 
+/* Function that initializes the printers' spools and the terminals' transmit rings. This function is called once by main() in initial.c. */
+void outInit(){
+	int i; /* loop variable */
+
+	for (i = 0; i < OUTRINGCNT; i++){
+		if (i < DEVPERINT){ /* the first DEVPERINT rings belong to the printers */
+			outBuf[i] = prntSpool[i];
+			outSize[i] = PRNTSPOOLSIZE;
+		}
+		else{
+			outBuf[i] = termRing[i - DEVPERINT];
+			outSize[i] = TERMRINGSIZE;
+		}
+		outHead[i] = 0;
+		outCnt[i] = 0;
+		outBusy[i] = FALSE;
+		outWaiting[i] = FALSE;
+		outError[i] = NOOUTERR;
+	}
+}
+
+/* Internal helper function that issues the character at the head of output ring ring to its device. A printer is handed the character in
+its DATA0 field, while a terminal's transmitter takes it in its TRANSM_COMMAND field alongside the command code. */
+void outStart(int ring){
+	/* declaring local variables */
+	devregarea_t *temp; /* device register area that we can use to write the device's command */
+	int index; /* the index in devreg of the device that owns the ring */
+	int c; /* the character to output */
+
+	temp = (devregarea_t *) RAMBASEADDR; /* initialization of temp */
+	c = outBuf[ring][outHead[ring]];
+	if (ring < DEVPERINT){ /* if the ring is a printer's spool */
+		index = ((PRNTINT - OFFSET) * DEVPERINT) + ring;
+		temp->devreg[index].d_data0 = c; /* placing the character to be printed into the printer's DATA0 field */
+		temp->devreg[index].d_command = PRINTCHR; /* placing the command code for printing the character into the printer's command field */
+	}
+	else{
+		index = ((TERMINT - OFFSET) * DEVPERINT) + (ring - DEVPERINT);
+		temp->devreg[index].t_transm_command = (c << TERMSHIFT) | TRANSMITCHAR; /* placing the command code for printing the character into the terminal's command field (and the character to be printed) */
+	}
+}
+
+/* Function that copies as many of the len characters starting at buf into the output ring of device devNo on line lineNum (PRNTINT
+or TERMINT) as there is room for, and that starts the device if it is idle. The function returns the number of characters copied; if
+that is less than len, the caller is recorded as waiting and must block on the device's semaphore (via SYS5) before retrying with
+the rest. The caller disables interrupts before calling this function and keeps them disabled until it has blocked, so that the
+wake-up issued by IOInt() cannot be missed. */
+int outEnqueue(int lineNum, int devNo, char *buf, int len){
+	/* declaring local variables */
+	int ring; /* the output ring of the device */
+	int copied; /* the number of characters copied into the ring */
+
+	ring = OUTRING(lineNum, devNo);
+	copied = 0;
+	while ((copied < len) && (outCnt[ring] < outSize[ring])){ /* while there are characters left and there is room for them in the ring */
+		outBuf[ring][(outHead[ring] + outCnt[ring]) % outSize[ring]] = buf[copied];
+		outCnt[ring]++;
+		copied++;
+	}
+
+	if ((!outBusy[ring]) && (outCnt[ring] > 0)){ /* if the device is idle, start it on the first character in the ring */
+		outBusy[ring] = TRUE;
+		outStart(ring); /* calling the internal helper function that issues the character to the device */
+	}
+	if (copied < len){ /* if the ring is full, the caller will wait for it to drain */
+		outWaiting[ring] = TRUE;
+	}
+	return copied;
+}
+
+/* Function that returns TRUE if device devNo on line lineNum still has characters in its output ring, in which case the caller is recorded
+as waiting and must block on the device's semaphore (via SYS5) before checking again. As with outEnqueue(), the caller disables interrupts
+before calling this function. */
+int outDrain(int lineNum, int devNo){
+	int ring; /* the output ring of the device */
+
+	ring = OUTRING(lineNum, devNo);
+	if (outBusy[ring]){
+		outWaiting[ring] = TRUE;
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/* Function that returns (and clears) the first error status returned by device devNo on line lineNum since the last call (NOOUTERR if none). */
+int outTakeError(int lineNum, int devNo){
+	int ring; /* the output ring of the device */
+	int status; /* the device's error status */
+
+	ring = OUTRING(lineNum, devNo);
+	status = outError[ring];
+	outError[ring] = NOOUTERR;
+	return status;
+}
+
+/* Internal helper function that handles a completion interrupt on the device that owns output ring ring, whose (already acknowledged)
+status was statusCode. The function records the status if it is an error (discarding the rest of the ring), issues the next character
+in the ring if there is one, and returns TRUE if a writer waiting on the device's semaphore should now be woken (i.e., the ring has
+drained to half of its size or the device has gone idle). */
+int outputInt(int ring, int statusCode){
+	/* declaring local variables */
+	int okStatus; /* the status the device returns when it has output a character */
+
+	if (outBusy[ring]){ /* if the completed character came from the ring, remove it */
+		outHead[ring] = (outHead[ring] + 1) % outSize[ring];
+		outCnt[ring]--;
+	}
+	okStatus = CHARTRANSM;
+	if (ring < DEVPERINT){ /* a printer reports a printed character by returning to "Ready" */
+		okStatus = READY;
+	}
+	if ((statusCode & TERMSTATUSON) != okStatus){ /* if the device returned an error, keep the first one and discard the rest of the ring */
+		if (outError[ring] == NOOUTERR){
+			outError[ring] = statusCode & TERMSTATUSON;
+		}
+		outCnt[ring] = 0;
+	}
+
+	if (outCnt[ring] > 0){ /* if there are characters left in the ring, output the next one */
+		outStart(ring); /* calling the internal helper function that issues the character to the device */
+	}
+	else{
+		outBusy[ring] = FALSE;
+	}
+
+	if ((outWaiting[ring]) && (outCnt[ring] <= (outSize[ring] / 2))){ /* if the waiting writer can now make progress */
+		outWaiting[ring] = FALSE;
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/* Function that initializes the terminals' input rings and starts the receiver of each installed terminal. This function is called
+once by main() in initial.c. */
+void inInit(){
+	/* declaring local variables */
+	devregarea_t *temp; /* device register area that we can use to determine which terminals are installed */
+	int i; /* loop variable */
+
+	temp = (devregarea_t *) RAMBASEADDR; /* initialization of temp */
+	for (i = 0; i < DEVPERINT; i++){
+		inHead[i] = 0;
+		inCnt[i] = 0;
+		inLineCnt[i] = 0;
+		inBusy[i] = FALSE;
+		inWaiting[i] = FALSE;
+		inError[i] = NOOUTERR;
+		if (((temp->inst_dev[TERMINT - OFFSET]) & (DEV0INT << i)) != ALLOFF){ /* if terminal i is installed */
+			inStart(i); /* calling the internal helper function that starts the terminal's receiver */
+		}
+	}
+}
+
+/* Internal helper function that issues a receive command to terminal devNo, so that the next character typed is placed in its input ring. */
+void inStart(int devNo){
+	devregarea_t *temp; /* device register area that we can use to write the terminal's receive command */
+
+	temp = (devregarea_t *) RAMBASEADDR; /* initialization of temp */
+	inBusy[devNo] = TRUE;
+	temp->devreg[((TERMINT - OFFSET) * DEVPERINT) + devNo].t_recv_command = RECEIVECHAR; /* placing the command code for receiving a character into the terminal's command field */
+}
+
+/* Internal helper function that returns TRUE if a reader of terminal devNo's input ring may proceed, meaning that the ring holds a
+complete line, that the ring is full (so no newline can arrive until some of it is read) or that the receiver has returned an error. */
+int inReady(int devNo){
+	return ((inLineCnt[devNo] > 0) || (inCnt[devNo] == TERMINSIZE) || (inError[devNo] != NOOUTERR));
+}
+
+/* Function that returns TRUE if no line can yet be read from terminal devNo's input ring, in which case the caller is recorded as
+waiting and must block on the terminal's receive semaphore (via SYS5) before checking again. The caller disables interrupts before
+calling this function and keeps them disabled until it has blocked, so that the wake-up issued by IOInt() cannot be missed. */
+int inWait(int devNo){
+	if (inReady(devNo)){
+		return FALSE;
+	}
+	inWaiting[devNo] = TRUE;
+	return TRUE;
+}
+
+/* Function that removes the next line from terminal devNo's input ring and copies it (including its newline) into buf, which holds
+MAXSTRLEN characters; a longer line is handed over in MAXSTRLEN-character pieces. The function returns the number of characters copied,
+or the negative of the receiver's status value if the receiver returned an error since the last call. As with inWait(), the caller
+disables interrupts before calling this function, and it only calls it once inWait() has returned FALSE. */
+int inDequeue(int devNo, char *buf){
+	/* declaring local variables */
+	int copied; /* the number of characters copied into buf */
+	int status; /* the receiver's error status */
+
+	if (inError[devNo] != NOOUTERR){ /* if the receiver returned an error, report it (and restart the receiver) */
+		status = inError[devNo];
+		inError[devNo] = NOOUTERR;
+		if (!inBusy[devNo]){
+			inStart(devNo); /* calling the internal helper function that restarts the terminal's receiver */
+		}
+		return status * (-1);
+	}
+
+	copied = 0;
+	while ((copied < MAXSTRLEN) && (inCnt[devNo] > 0)){ /* while buf has room and the ring has characters */
+		buf[copied] = inRing[devNo][inHead[devNo]];
+		inHead[devNo] = (inHead[devNo] + 1) % TERMINSIZE;
+		inCnt[devNo]--;
+		copied++;
+		if (buf[copied - 1] == NEWLINE){ /* the line is complete */
+			inLineCnt[devNo]--;
+			break;
+		}
+	}
+
+	if ((!inBusy[devNo]) && (inCnt[devNo] < TERMINSIZE)){ /* if the receiver was stopped because the ring was full, restart it */
+		inStart(devNo); /* calling the internal helper function that restarts the terminal's receiver */
+	}
+	return copied;
+}
+
+/* Internal helper function that handles a receive-completion interrupt on terminal devNum, whose (already acknowledged) receive status was
+statusCode. The function applies the line discipline to the received character (a backspace or delete removes the last character of the
+line being typed, while any other character is appended to the ring), restarts the receiver if the ring still has room, and returns
+TRUE if a reader waiting on the terminal's receive semaphore should now be woken. */
+int inputInt(int devNum, int statusCode){
+	/* declaring local variables */
+	char c; /* the character received */
+	int last; /* the index in inRing of the last character in the ring */
+
+	inBusy[devNum] = FALSE;
+	if ((statusCode & TERMSTATUSON) != CHARRECV){ /* if the receiver returned an error, keep the first one and leave the receiver stopped */
+		if (inError[devNum] == NOOUTERR){
+			inError[devNum] = statusCode & TERMSTATUSON;
+		}
+	}
+	else{
+		c = (statusCode >> TERMCHARSHIFT) & TERMCHARMASK; /* the received character is in the second byte of the status field */
+		last = (inHead[devNum] + inCnt[devNum] + TERMINSIZE - 1) % TERMINSIZE;
+		if ((c == BACKSPACE) || (c == DELETECHAR)){ /* if the character erases the last character of the line being typed */
+			if ((inCnt[devNum] > 0) && (inRing[devNum][last] != NEWLINE)){
+				inCnt[devNum]--;
+			}
+		}
+		else{
+			inRing[devNum][(last + 1) % TERMINSIZE] = c;
+			inCnt[devNum]++;
+			if (c == NEWLINE){
+				inLineCnt[devNum]++;
+			}
+		}
+		if (inCnt[devNum] < TERMINSIZE){ /* if the ring still has room, receive the next character */
+			inStart(devNum); /* calling the internal helper function that restarts the terminal's receiver */
+		}
+	}
+
+	if ((inWaiting[devNum]) && (inReady(devNum))){ /* if the waiting reader can now read a line */
+		inWaiting[devNum] = FALSE;
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/* Function that initializes the disks' and flash devices' request queues. This function is called once by main() in initial.c. */
+void reqInit(){
+	int i; /* loop variable */
+
+	for (i = 0; i < REQQCNT; i++){
+		reqHead[i] = NULL;
+		reqTail[i] = NULL;
+	}
+}
+
+/* Internal function that writes the DATA0 and COMMAND fields of device devNo on line lineNum (DISKINT or FLASHINT) with the first request
+in the device's queue. */
+void reqStart(int lineNum, int devNo){
+	/* declaring local variables */
+	devregarea_t *temp; /* device register area that we can use to write the device's command */
+	devreq_t *req; /* the request being issued */
+	int index; /* the index in devreg of the device */
+
+	temp = (devregarea_t *) RAMBASEADDR; /* initialization of temp */
+	req = reqHead[REQQ(lineNum, devNo)];
+	index = ((lineNum - OFFSET) * DEVPERINT) + devNo;
+	temp->devreg[index].d_data0 = req->r_data0;
+	temp->devreg[index].d_command = req->r_command;
+}
+
+/* Function that appends the request req to the queue of device devNo on line lineNum (DISKINT or FLASHINT), issuing it if the device is
+idle. The caller disables interrupts before calling this function and then blocks on the device's semaphore (via SYS5) before enabling
+them again. Since the device's requests complete in the order they were submitted and its semaphore wakes blocked processes in the order
+they blocked, the caller is woken with the status code of its own request, and req (which typically lives on the caller's stack) is no
+longer referenced once the caller has been woken. */
+void reqSubmit(int lineNum, int devNo, devreq_t *req){
+	int q; /* the index of the device's request queue */
+
+	q = REQQ(lineNum, devNo);
+	req->r_next = NULL;
+	if (reqHead[q] == NULL){ /* if the device is idle, the request is issued at once */
+		reqHead[q] = req;
+		reqTail[q] = req;
+		reqStart(lineNum, devNo);
+		return;
+	}
+	reqTail[q]->r_next = req;
+	reqTail[q] = req;
+}
+
+/* Internal function that removes the request that device devNo on line lineNum (DISKINT or FLASHINT) has completed from the front of its
+queue and issues the next request (if there is one), so that the device starts it before its submitter is woken. */
+void reqNext(int lineNum, int devNo){
+	int q; /* the index of the device's request queue */
+
+	q = REQQ(lineNum, devNo);
+	if (reqHead[q] == NULL){ /* if the device was not performing a queued request, there is nothing to remove */
+		return;
+	}
+	reqHead[q] = reqHead[q]->r_next;
+	if (reqHead[q] == NULL){ /* if the queue is now empty, the device stays idle */
+		reqTail[q] = NULL;
+		return;
+	}
+	reqStart(lineNum, devNo);
+}
+
 /* Function that represents the entry point into this module when handling interrupts. This function's tasks include initializing the
 global variables in this module, and identifying the type of interrupt that has the highest priority, so that it can then invoke
 the internal function that handles that specific type of interrupt. */
@@ -28,6 +28,7 @@
 #include "../h/const.h"
 #include "../h/pcb.h"
 #include "../h/scheduler.h"
+#include "../h/exceptions.h"
 #include "../h/interrupts.h"
 #include "../h/initial.h"
 #include "/usr/include/umps3/umps/libumps.h"
@@ -55,6 +56,7 @@ represents the time that the process begins executing at, as the function then p
 state so that it can begin (or perhaps resume) execution. */
 void switchContext(pcb_PTR curr_proc){
 	currentProc = curr_proc; /* setting the Current Process to curr_proc */
+	loadWiredTlb(curr_proc); /* loading the wired TLB entry with the process' stack page, if it is a newly dispatched U-proc */
 	STCK(start_tod); /* updating start_tod with the value on the Time of Day Clock, as this is the time that the process will begin executing at */
 	LDST(&(curr_proc->p_s)); /* loading the processor state for the processor state stored in pcb of the Current Process */
 }
@@ -6,8 +6,8 @@
  * the exception code is 8, then control is passed to the sysTrapHandler() function;
  * otherwise, control is passed to the phase 3 Program Trap handler. The Program
  * Trap handler simply executes a SYS9 and termiantes the running U-proc. On the
- * other hand, the phase 3 System Trap Handler function handles SYSCALLS 9, 10
- * and 12 when the running process is in kernel-mode. The function determines which
+ * other hand, the phase 3 System Trap Handler function handles SYSCALLS 9 through
+ * 28 when the running process is in kernel-mode. The function determines which
  * SYSCALL number was requested and then passes control to the appropriate internal
  * helper function. Once the SYSCALL is handled, control is passed back to
  * the requesting U-proc.
@@ -28,12 +28,29 @@
 #include "../h/initProc.h"
 #include "../h/vmSupport.h"
 #include "../h/sysSupport.h"
+#include "../h/deviceSupportDMA.h"
+#include "../h/delayDaemon.h"
+#include "../h/vsemSupport.h"
 #include "/usr/include/umps3/umps/libumps.h"
 
 /* function declarations */
 HIDDEN void terminateUProc();
 HIDDEN void getTOD(state_PTR savedState);
-HIDDEN void writeToTerminal(char *virtAddr, int strLength, int procASID, state_PTR savedState);
+HIDDEN void writeToDevice(int lineNum, char *virtAddr, int strLength, support_t *curProcSupportStruct, state_PTR savedState);
+HIDDEN void readTerminal(char *virtAddr, support_t *curProcSupportStruct, state_PTR savedState);
+HIDDEN void diskTransfer(int readOrWrite, memaddr virtAddr, int diskNo, int sectNo, support_t *curProcSupportStruct, state_PTR savedState);
+HIDDEN void flashBlockTransfer(int readOrWrite, memaddr virtAddr, int devNo, int blockNo, support_t *curProcSupportStruct, state_PTR savedState);
+HIDDEN void syncFlashCache(state_PTR savedState);
+HIDDEN void delay(int secs, int procASID, state_PTR savedState);
+HIDDEN void virtualSemOp(int isP, memaddr semAdd, support_t *curProcSupportStruct, state_PTR savedState);
+HIDDEN void attachSegment(int key, int pgCnt, int mode, support_t *curProcSupportStruct, state_PTR savedState);
+HIDDEN void detachSegment(int key, support_t *curProcSupportStruct, state_PTR savedState);
+HIDDEN void lockPages(memaddr virtAddr, int len, support_t *curProcSupportStruct, state_PTR savedState);
+HIDDEN void unlockPages(memaddr virtAddr, int len, support_t *curProcSupportStruct, state_PTR savedState);
+HIDDEN void mapFlashBlocks(int devNo, int firstBlock, int pgCnt, support_t *curProcSupportStruct, state_PTR savedState);
+HIDDEN int findRegion(memaddr virtAddr);
+HIDDEN void syncFlashMapping(memaddr virtAddr, support_t *curProcSupportStruct, state_PTR savedState);
+HIDDEN void unmapFlashMapping(memaddr virtAddr, support_t *curProcSupportStruct, state_PTR savedState);
 HIDDEN void sysTrapHandler(state_PTR savedState, support_t *curProcSupportStruct);
 
 /* Function that handles all passed up non-TLB exceptions (i.e., all SYSCALL exceptions numbered 9 and above, as well as all Program
@@ -61,11 +78,27 @@ void vmGeneralExceptionHandler(){
 }
 
 /* Internal function that handles SYS9 requests. This function kills the executing User Process by calling the Nucleus' SYS2 
-function while in kernel-mode. Before issuing the SYS2, it also performs a V operation on masterSemaphore in order to ensure that
+function while in kernel-mode. Before issuing the SYS2, it unmaps the U-proc's mapped flash regions (writing their dirty pages back), detaches the U-proc's shared memory segments and returns the U-proc's frames to the Swap Pool (which may allow a U-proc
+suspended by the Pager's load control to resume), writes the flash block cache's dirty blocks back to flash, and it waits for the U-proc's printer and terminal to output what is left in their output rings, so
+that output is not lost when test() halts. It also performs a V operation on masterSemaphore in order to ensure that
 test() comes to a more gracious conclusion. */
 void terminateUProc(){
     /* We are in kernel-mode already */
+    support_t *curProcSupportStruct; /* a pointer to the Current Process' Support Structure */
 
+    curProcSupportStruct = (support_t *) SYSCALL(SYS8NUM, 0, 0, 0); /* obtaining a pointer to the Current Process' Support Structure */
+    mmapUnmapAll(curProcSupportStruct); /* unmapping every flash region the U-proc has mapped */
+    shmDetachAll(curProcSupportStruct); /* detaching every shared memory segment the U-proc has attached */
+    releaseUProcFrames(curProcSupportStruct->sup_asid); /* returning the U-proc's frames to the Swap Pool */
+    bcacheFlush(); /* calling the function in deviceSupportDMA.c that writes the flash block cache's dirty blocks back to flash */
+    setInterrupts(FALSE); /* calling the function that disables interrupts so that checking the output rings and blocking on them happen atomically */
+    while (outDrain(PRNTINT, curProcSupportStruct->sup_asid - 1)){ /* while the U-proc's printer still has characters to print */
+        SYSCALL(SYS5NUM, PRNTINT, (curProcSupportStruct->sup_asid - 1), WRITE); /* issuing the SYS 5 call to block the U-proc until the spool has drained */
+    }
+    while (outDrain(TERMINT, curProcSupportStruct->sup_asid - 1)){ /* while the U-proc's terminal still has characters to transmit */
+        SYSCALL(SYS5NUM, TERMINT, (curProcSupportStruct->sup_asid - 1), WRITE); /* issuing the SYS 5 call to block the U-proc until the ring has drained */
+    }
+    setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register */
     SYSCALL(SYS4NUM, (unsigned int) &masterSemaphore, 0, 0); /* performing a V operation on masterSemaphore, to come to a more graceful conclusion */
     SYSCALL(SYS2NUM, 0, 0, 0); /* issuing a SYS2 to terminate the U-proc */
 }
@@ -81,58 +114,363 @@ void getTOD(state_PTR savedState){
     switchUContext(savedState); /* returning control to the Current Process by loading its (updated) processor state */
 }	
 
-/* Internal function that handles SYS12 requests. This function causes the requesting user-process to be suspended until
-a complete string of characters (of length strLength, with first character at address virtAddr) has been transmitted to the
-terminal device associated with the user-process. Once the user-process resumes, this function returns in the process' v0 register either:
-- the number of characters actually transmitted, if the write was successful or
-- the negative of the terminal device's status value (if the operation ends with a status other than "Character Transmitted"). */
-void writeToTerminal(char *virtAddr, int strLength, int procASID, state_PTR savedState){
+/* Internal function that handles SYS11 and SYS12 requests. This function copies a string of characters (of length strLength, with first
+character at address virtAddr) into the Nucleus' output ring for the printer (if lineNum is PRNTINT) or terminal (if lineNum is TERMINT)
+associated with the user-process, which outputs it one character per interrupt. The whole string is validated before any of it is
+output, and it is then copied out of the U-proc's address space with copyIn() in pieces of up to MAXSTRLEN characters, so that its
+length is not limited by the size of the kernel buffer and no TLB exception is raised in the middle of the copy. The user-process is
+only suspended while the ring is too full to take the rest of a piece, so it normally resumes (and continues computing) before the
+string has been output. This function returns in the process' v0 register either:
+- the number of characters written, if the write was successful or
+- the negative of the device's status value, if the device has returned a status other than "Device Ready" (for a printer) or
+"Character Transmitted" (for a terminal) since the previous write (in which case the characters that had not yet been output are discarded). */
+void writeToDevice(int lineNum, char *virtAddr, int strLength, support_t *curProcSupportStruct, state_PTR savedState){
 	/* declaring local variables */
-    devregarea_t *temp; /* pointer to device register area that we can use to read and write the process procASID's terminal device */
-    int index; /* the index in devreg (and in devSemaphores) of the terminal device associated with process procASID */
-	unsigned int status; /* the contents of the terminal device's status register after a SYS5 call is issued */
-	int statusCode; /* the status code returned by the terminal device after a SYS5 call is issued */
+	char buf[MAXSTRLEN]; /* the piece of the string being output, copied out of the U-proc's address space before interrupts are disabled */
+	int procASID; /* the ASID of the U-proc, which identifies its device */
+	int done; /* the number of characters of the string copied into the output ring so far */
+	int len; /* the number of characters in the piece being output */
+	int sent; /* the number of characters of the piece placed in the output ring so far */
+	int statusCode; /* the error status returned by the device (NOOUTERR if none) */
 
     /* pre-checks: (each lead to SYS9)
-        error if addr outside of u-proc's logical address space (KUSEG)
         error if strLength < 0
-        error if strLength > 128 */
-    if (((unsigned int) virtAddr < KUSEG) || (strLength < 0) || (strLength > MAXSTRLEN)){
+        error if the string does not lie within the u-proc's logical address space */
+    if ((strLength < 0) || (!validRange(curProcSupportStruct, (memaddr) virtAddr, strLength, FALSE))){
         terminateUProc(); /* calling the internal function that handles SYS9 requests to terminate the U-proc, as the request info is an error */
     }
 
-	/* initializing local variables, except for status and statusCode, which will be initialized later */
-	temp = (devregarea_t *) RAMBASEADDR; /* initialization of temp */
-    index = ((TERMINT - OFFSET) * DEVPERINT) + (procASID - 1); /* index of terminal device associated with the U-proc; note that terminal device semaphores for writing come after those for reading */
-    
-    mutex(TRUE, (int *) &(devSemaphores[index + DEVPERINT])); /* calling the function that gains mutual exclusion over the appropriate terminal device's device register */
-
-	/* transmitting each character to the terminal */
-    int i;
-    for (i = 0; i < strLength; i++){
-		setInterrupts(FALSE); /* calling the function that disables interrupts in order to write the COMMAND field and issue the SYS 5 atomically */
-    	temp->devreg[index].t_transm_command = (*(virtAddr + i)  << TERMSHIFT) | TRANSMITCHAR; /* placing the command code for printing the character into the terminal's command field (and the character to be printed) */
-    	status = SYSCALL(SYS5NUM, LINE7, (procASID - 1), WRITE); /* issuing the SYS 5 call to block the I/O requesting process until the operation completes */
-		setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
-		statusCode = status & TERMSTATUSON; /* setting the status code returned by the terminal device after the SYS5 call */
-	    
-		if (statusCode != CHARTRANSM){ /* if the write operation led to an error status */
-			savedState->s_v0 = statusCode * (-1); /* returning the negative of the status code */
-			mutex(FALSE, (int *) &(devSemaphores[index + DEVPERINT])); /* calling the function that releases mutual exclusion over the appropriate terminal device's device register */
-   			switchUContext(savedState); /* return control back to the Current Process */
+	procASID = curProcSupportStruct->sup_asid;
+	statusCode = NOOUTERR;
+	done = 0;
+	while ((done < strLength) && (statusCode == NOOUTERR)){ /* while there are characters left and the device has not returned an error */
+		len = strLength - done;
+		if (len > MAXSTRLEN){
+			len = MAXSTRLEN;
 		}
-    }
-	
-	/* the write operation was successful */
-	savedState->s_v0 = strLength; /* return length of string transmitted */
-	mutex(FALSE, (int *) &(devSemaphores[index + DEVPERINT])); /* calling the function that releases mutual exclusion over the appropriate terminal device's device register */
+		copyIn(curProcSupportStruct, buf, (memaddr) (virtAddr + done), len); /* calling the function in vmSupport.c that copies the piece while interrupts are enabled, since bringing in its pages may cause page faults */
+
+		/* placing the piece in the output ring, waiting for the ring to drain whenever it is full; since the device is only written by
+		this U-proc, interrupts being disabled is all the mutual exclusion the ring needs */
+		setInterrupts(FALSE); /* calling the function that disables interrupts so that filling the ring and blocking on a full ring happen atomically */
+		sent = outEnqueue(lineNum, procASID - 1, buf, len); /* calling the function in interrupts.c that copies the piece into the ring */
+		while (sent < len){ /* while the ring was too full to take the rest of the piece */
+			SYSCALL(SYS5NUM, lineNum, (procASID - 1), WRITE); /* issuing the SYS 5 call to block the U-proc until the ring has drained */
+			sent += outEnqueue(lineNum, procASID - 1, buf + sent, len - sent);
+		}
+		statusCode = outTakeError(lineNum, procASID - 1); /* calling the function in interrupts.c that collects any error returned by the device */
+		setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+		done += len;
+	}
+
+	if (statusCode != NOOUTERR){ /* if the device returned an error status */
+		savedState->s_v0 = statusCode * (-1); /* returning the negative of the status code */
+		switchUContext(savedState); /* return control back to the Current Process */
+	}
+	savedState->s_v0 = strLength; /* return length of string written */
    	switchUContext(savedState); /* return control back to the Current Process */
 }
 
+/* Internal function that handles SYS13 requests. This function suspends the requesting user-process until a whole line (ending
+in a newline) has been typed on the terminal device associated with the user-process, and then copies that line (including its
+newline) into the process' buffer, whose first character is at address virtAddr, with copyOut(). The line comes from the Nucleus'
+input ring for the terminal, which receives characters (and applies backspaces) even while no process is reading. If a buffer of
+MAXSTRLEN characters does not fit in the U-proc's address space (or would overwrite its .text), the U-proc is terminated before the
+line is removed from the input ring, so that no typed line is lost. This function returns in the process'
+v0 register either:
+- the number of characters read, if the read was successful or
+- the negative of the terminal device's status value, if the terminal has returned a status other than "Character Received" since
+the previous SYS13. */
+void readTerminal(char *virtAddr, support_t *curProcSupportStruct, state_PTR savedState){
+	/* declaring local variables */
+	char buf[MAXSTRLEN]; /* the line, which is copied into the U-proc's address space after interrupts are enabled again */
+	int procASID; /* the ASID of the U-proc, which identifies its terminal */
+	int cnt; /* the number of characters in the line (or the negative of the terminal's status value) */
+
+	/* pre-check: (leads to SYS9)
+		error if a line of MAXSTRLEN characters would not fit in u-proc's logical address space (or would overwrite its .text) */
+	if (!validRange(curProcSupportStruct, (memaddr) virtAddr, MAXSTRLEN, TRUE)){
+		terminateUProc(); /* calling the internal function that handles SYS9 requests to terminate the U-proc, as the request info is an error */
+	}
+
+	procASID = curProcSupportStruct->sup_asid;
+	setInterrupts(FALSE); /* calling the function that disables interrupts so that checking the input ring and blocking on it happen atomically (the terminal is only read by this U-proc) */
+	while (inWait(procASID - 1)){ /* while the terminal has not yet received a whole line */
+		SYSCALL(SYS5NUM, LINE7, (procASID - 1), READ); /* issuing the SYS 5 call to block the U-proc until a line has been received */
+	}
+	cnt = inDequeue(procASID - 1, buf); /* calling the function in interrupts.c that removes the line from the input ring */
+	setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+
+	/* copying the line while interrupts are enabled, since bringing in the buffer's pages may cause page faults */
+	if ((cnt > 0) && (!copyOut(curProcSupportStruct, (memaddr) virtAddr, buf, cnt))){ /* if the line does not fit in the U-proc's buffer (leads to SYS9) */
+		terminateUProc(); /* calling the internal function that handles SYS9 requests to terminate the U-proc, as the request info is an error */
+	}
+	savedState->s_v0 = cnt; /* return the number of characters read (or the negative of the status code) */
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
+/* Internal function that handles SYS14 (if readOrWrite is READ) and SYS15 (if readOrWrite is WRITE) requests. This function reads sector
+sectNo of disk diskNo into the PAGESIZE bytes starting at virtAddr, or writes those bytes to the sector, by calling diskOperation() in
+deviceSupportDMA.c, which orders the requests waiting for each disk with an elevator (and transfers the sector directly to or from the
+U-proc's frame if virtAddr is page-aligned). This function returns in the U-proc's v0 register
+either:
+- the disk's status value, if the operation was successful or
+- the negative of the disk's status value, if the operation led to an error status. */
+void diskTransfer(int readOrWrite, memaddr virtAddr, int diskNo, int sectNo, support_t *curProcSupportStruct, state_PTR savedState){
+	/* pre-checks: (each lead to SYS9)
+		error if the page does not lie within the u-proc's logical address space (or is read-only .text, for a read)
+		error if diskNo is not a disk device number
+		error if sectNo does not lie on the disk */
+	if ((!validRange(curProcSupportStruct, virtAddr, PAGESIZE, (readOrWrite == READ))) || (diskNo < 0) || (diskNo >= DEVPERINT) || (sectNo < 0) || (sectNo >= diskSectorCnt(diskNo))){
+		terminateUProc(); /* calling the internal function that handles SYS9 requests to terminate the U-proc, as the request info is an error */
+	}
+
+	savedState->s_v0 = diskOperation(readOrWrite, diskNo, sectNo, virtAddr, curProcSupportStruct); /* calling the function in deviceSupportDMA.c that performs the transfer */
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
+/* Internal function that handles SYS16 (if readOrWrite is READ) and SYS17 (if readOrWrite is WRITE) requests. This function reads block
+blockNo of flash device devNo into the PAGESIZE bytes starting at virtAddr, or writes those bytes to the block, through the flash block
+cache in deviceSupportDMA.c (so a written block only reaches flash later; see SYS28), unless virtAddr is page-aligned, in which case the
+block is transferred directly to or from the U-proc's frame. This function returns in the U-proc's v0 register
+either:
+- the flash device's "Device Ready" status value, if the operation was successful or
+- the negative of the flash device's status value, if reading or writing the block (or writing back the block it replaced in the cache)
+led to an error status. A U-proc may only use its own flash device among the ones holding load images, and may not use a device that
+any U-proc has mapped (with SYS25). */
+void flashBlockTransfer(int readOrWrite, memaddr virtAddr, int devNo, int blockNo, support_t *curProcSupportStruct, state_PTR savedState){
+	/* pre-checks: (each lead to SYS9)
+		error if the page does not lie within the u-proc's logical address space (or is read-only .text, for a read)
+		error if devNo is not a flash device number, or is a swap device
+		error if devNo holds another u-proc's load image
+		error if devNo has been mapped by any u-proc
+		error if blockNo does not lie on the device */
+	if ((!validRange(curProcSupportStruct, virtAddr, PAGESIZE, (readOrWrite == READ))) || (devNo < 0) || (devNo >= DEVPERINT) || (ISSWAPDEV(devNo))
+		|| ((devNo < UPROCMAX) && (devNo != curProcSupportStruct->sup_asid - 1)) || ((devNo >= MMAPDEVBASE) && (mmapDevMapped(devNo)))
+		|| (blockNo < 0) || (blockNo >= flashBlockCnt(devNo))){
+		terminateUProc(); /* calling the internal function that handles SYS9 requests to terminate the U-proc, as the request info is an error */
+	}
+
+	savedState->s_v0 = bcacheOperation(readOrWrite, devNo, blockNo, virtAddr, curProcSupportStruct); /* calling the function in deviceSupportDMA.c that performs the transfer */
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
+/* Internal function that handles SYS28 requests. This function writes every dirty block in the flash block cache back to flash, and
+returns in the U-proc's v0 register either SUCCESSCONST or the negative of the status value of the first write that led to an error status. */
+void syncFlashCache(state_PTR savedState){
+	savedState->s_v0 = bcacheFlush(); /* calling the function in deviceSupportDMA.c that writes the dirty blocks back to flash */
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
+/* Internal function that handles SYS18 requests. This function suspends the requesting U-proc for at least secs seconds by calling
+delayUProc() in delayDaemon.c, and then returns control to the U-proc. */
+void delay(int secs, int procASID, state_PTR savedState){
+	/* pre-check: (leads to SYS9)
+		error if secs < 0 */
+	if (secs < 0){
+		terminateUProc(); /* calling the internal function that handles SYS9 requests to terminate the U-proc, as the request info is an error */
+	}
+
+	delayUProc(procASID, secs); /* calling the function in delayDaemon.c that waits until the delay daemon wakes the U-proc */
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
+/* Internal function that handles SYS19 (if isP is TRUE) and SYS20 (if isP is FALSE) requests. This function performs a P or V operation
+on the virtual semaphore at semAdd in the U-proc's logical address space by calling vsemP() or vsemV() in vsemSupport.c, and then
+returns control to the U-proc. */
+void virtualSemOp(int isP, memaddr semAdd, support_t *curProcSupportStruct, state_PTR savedState){
+	/* declaring local variables */
+	int done; /* whether the operation was performed */
+
+	/* pre-checks: (each lead to SYS9)
+		error if addr outside of u-proc's logical address space (KUSEG)
+		error if addr is not word-aligned */
+	if ((semAdd < KUSEG) || ((semAdd % WORDLEN) != 0)){
+		terminateUProc(); /* calling the internal function that handles SYS9 requests to terminate the U-proc, as the request info is an error */
+	}
+
+	if (isP == TRUE){
+		done = vsemP(curProcSupportStruct, semAdd); /* calling the function in vsemSupport.c that performs the P operation */
+	}
+	else{
+		done = vsemV(curProcSupportStruct, semAdd); /* calling the function in vsemSupport.c that performs the V operation */
+	}
+	if (done == FALSE){ /* if the semaphore does not lie in a writable page of the U-proc's address space */
+		terminateUProc(); /* calling the internal function that handles SYS9 requests to terminate the U-proc */
+	}
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
+/* Internal function that handles SYS21 requests. This function attaches the shared memory segment named key to the requesting U-proc,
+creating it with pgCnt pages if no U-proc has it attached. If mode is SHMCOW, the segment is attached copy-on-write, so the U-proc's
+stores into the segment are not seen by other U-procs; otherwise (SHMSHARED) every U-proc attaching the segment sees the stores of the
+others. This function returns in the U-proc's v0 register either:
+- the virtual address at which the segment is mapped (the same in every U-proc), if the segment was attached or
+- ERRORCONST, if an existing segment named key has fewer than pgCnt pages or every segment is in use. */
+void attachSegment(int key, int pgCnt, int mode, support_t *curProcSupportStruct, state_PTR savedState){
+	/* declaring local variables */
+	int segNo; /* the number of the segment that was attached */
+
+	/* pre-checks: (each lead to SYS9)
+		error if pgCnt <= 0 or pgCnt > SHMPGMAX
+		error if mode is neither SHMSHARED nor SHMCOW */
+	if ((pgCnt <= 0) || (pgCnt > SHMPGMAX) || ((mode != SHMSHARED) && (mode != SHMCOW))){
+		terminateUProc(); /* calling the internal function that handles SYS9 requests to terminate the U-proc, as the request info is an error */
+	}
+
+	segNo = shmAttach(curProcSupportStruct, key, pgCnt, mode); /* calling the function in vmSupport.c that attaches the segment */
+	if (segNo == NOSEG){ /* if the segment could not be attached */
+		savedState->s_v0 = ERRORCONST;
+	}
+	else{
+		savedState->s_v0 = PGNOTOVPN(SHMBASEPGNO + (segNo * SHMPGMAX)) << VPNSHIFT; /* returning the address of the segment's first page */
+	}
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
+/* Internal function that handles SYS22 requests. This function detaches the shared memory segment named key from the requesting
+U-proc (destroying the segment if no other U-proc has it attached) and returns in the U-proc's v0 register either SUCCESSCONST, or
+ERRORCONST if the U-proc had not attached the segment. */
+void detachSegment(int key, support_t *curProcSupportStruct, state_PTR savedState){
+	if (shmDetach(curProcSupportStruct, key) == TRUE){ /* if the segment was detached */
+		savedState->s_v0 = SUCCESSCONST;
+	}
+	else{
+		savedState->s_v0 = ERRORCONST;
+	}
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
+/* Internal function that handles SYS23 requests. This function pins the pages of the requesting U-proc that hold the len bytes starting
+at virtAddr into the Swap Pool, so that they remain resident until they are unpinned (or the U-proc terminates). This function
+returns in the U-proc's v0 register either SUCCESSCONST, or ERRORCONST if pinning the pages would exceed the U-proc's quota or the
+system-wide limit, or if the range includes a page that cannot be pinned. A range that does not lie within the U-proc's address space
+terminates the U-proc. */
+void lockPages(memaddr virtAddr, int len, support_t *curProcSupportStruct, state_PTR savedState){
+	/* pre-checks: (each lead to SYS9)
+		error if len <= 0
+		error if len > PINQUOTA * PAGESIZE
+		error if any byte lies outside of u-proc's logical address space (or the range wraps around) */
+	if ((len <= 0) || (len > PINQUOTA * PAGESIZE) || (!validRange(curProcSupportStruct, virtAddr, len, FALSE))){
+		terminateUProc(); /* calling the internal function that handles SYS9 requests to terminate the U-proc, as the request info is an error */
+	}
+
+	if (pinRange(curProcSupportStruct, virtAddr, len) == TRUE){ /* if the pages were pinned */
+		savedState->s_v0 = SUCCESSCONST;
+	}
+	else{
+		savedState->s_v0 = ERRORCONST;
+	}
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
+/* Internal function that handles SYS24 requests. This function releases the requesting U-proc's pins on the pages that hold the len
+bytes starting at virtAddr (pages it has not pinned are ignored) and returns SUCCESSCONST in the U-proc's v0 register. A range that
+does not lie within the U-proc's address space terminates the U-proc. */
+void unlockPages(memaddr virtAddr, int len, support_t *curProcSupportStruct, state_PTR savedState){
+	/* pre-checks: (each lead to SYS9)
+		error if len <= 0
+		error if len > MAXUPAGES * PAGESIZE (the size of u-proc's logical address space)
+		error if any byte lies outside of u-proc's logical address space (or the range wraps around) */
+	if ((len <= 0) || (len > MAXUPAGES * PAGESIZE) || (!validRange(curProcSupportStruct, virtAddr, len, FALSE))){
+		terminateUProc(); /* calling the internal function that handles SYS9 requests to terminate the U-proc, as the request info is an error */
+	}
+
+	unpinPages(curProcSupportStruct, virtAddr, len); /* calling the function in vmSupport.c that releases the pins */
+	savedState->s_v0 = SUCCESSCONST;
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
+/* Internal function that handles SYS25 requests. This function maps the pgCnt blocks of flash device devNo starting at block firstBlock
+into the requesting U-proc's address space, so that the U-proc reads and writes them as ordinary memory (the Pager reads each page
+from its block on first access, and dirty pages are written back when they are evicted, on a SYS26 or SYS27, or when the U-proc
+terminates). This function returns in the U-proc's v0 register either:
+- the virtual address at which the blocks are mapped, if the blocks were mapped or
+- ERRORCONST, if the blocks lie beyond the end of the device or the U-proc has already mapped MMAPMAX regions. */
+void mapFlashBlocks(int devNo, int firstBlock, int pgCnt, support_t *curProcSupportStruct, state_PTR savedState){
+	/* declaring local variables */
+	int regionNo; /* the number of the region that was mapped */
+
+	/* pre-checks: (each lead to SYS9)
+		error if devNo is not a flash device that may be mapped (i.e., a U-proc's or a swap device)
+		error if firstBlock < 0
+		error if pgCnt <= 0 or pgCnt > MMAPPGMAX */
+	if ((devNo < MMAPDEVBASE) || (devNo >= DEVPERINT) || (firstBlock < 0) || (pgCnt <= 0) || (pgCnt > MMAPPGMAX)){
+		terminateUProc(); /* calling the internal function that handles SYS9 requests to terminate the U-proc, as the request info is an error */
+	}
+
+	regionNo = mmapMap(curProcSupportStruct, devNo, firstBlock, pgCnt); /* calling the function in vmSupport.c that maps the blocks */
+	if (regionNo == NOREGION){ /* if the blocks could not be mapped */
+		savedState->s_v0 = ERRORCONST;
+	}
+	else{
+		savedState->s_v0 = PGNOTOVPN(MMAPBASEPGNO + (regionNo * MMAPPGMAX)) << VPNSHIFT; /* returning the address of the region's first page */
+	}
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
+/* Internal function that returns the number of the mapped region that begins at the virtual address virtAddr (i.e., the address
+returned by the SYS25 that mapped it), or NOREGION if no region begins there. */
+int findRegion(memaddr virtAddr){
+	int pgNo;
+
+	pgNo = VPNTOPGNO((virtAddr & GETVPN) >> VPNSHIFT);
+	if (((virtAddr % PAGESIZE) != 0) || (pgNo < MMAPBASEPGNO) || (pgNo >= SHMBASEPGNO) || (((pgNo - MMAPBASEPGNO) % MMAPPGMAX) != 0)){ /* if the address is not the start of a region */
+		return NOREGION;
+	}
+	return (pgNo - MMAPBASEPGNO) / MMAPPGMAX;
+}
+
+/* Internal function that handles SYS26 requests. This function writes the dirty pages of the region that the requesting U-proc mapped at
+virtAddr back to the flash blocks they map, and returns in the U-proc's v0 register either:
+- SUCCESSCONST, if every dirty page was written,
+- the negative of the flash device's status value, if a write ended with a status other than "Device Ready" or
+- ERRORCONST, if the U-proc has not mapped a region at virtAddr. */
+void syncFlashMapping(memaddr virtAddr, support_t *curProcSupportStruct, state_PTR savedState){
+	/* declaring local variables */
+	int regionNo; /* the number of the region mapped at virtAddr */
+	int statusCode; /* the status code returned by the function that writes the region back */
+
+	regionNo = findRegion(virtAddr); /* calling the internal helper function to determine the region mapped at virtAddr */
+	statusCode = (regionNo == NOREGION) ? NOREGION : mmapSync(curProcSupportStruct, regionNo); /* calling the function in vmSupport.c that writes the region's dirty pages back */
+	if (statusCode == NOREGION){ /* if the U-proc has not mapped a region at virtAddr */
+		savedState->s_v0 = ERRORCONST;
+	}
+	else if (statusCode != READY){ /* if a write led to an error status */
+		savedState->s_v0 = statusCode * (-1); /* returning the negative of the status code */
+	}
+	else{
+		savedState->s_v0 = SUCCESSCONST;
+	}
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
+/* Internal function that handles SYS27 requests. This function writes the dirty pages of the region that the requesting U-proc mapped at
+virtAddr back to flash and unmaps the region, returning the same values as a SYS26 in the U-proc's v0 register. Note that the region
+is unmapped even if a write fails. */
+void unmapFlashMapping(memaddr virtAddr, support_t *curProcSupportStruct, state_PTR savedState){
+	/* declaring local variables */
+	int regionNo; /* the number of the region mapped at virtAddr */
+	int statusCode; /* the status code returned by the function that unmaps the region */
+
+	regionNo = findRegion(virtAddr); /* calling the internal helper function to determine the region mapped at virtAddr */
+	statusCode = (regionNo == NOREGION) ? NOREGION : mmapUnmap(curProcSupportStruct, regionNo); /* calling the function in vmSupport.c that unmaps the region */
+	if (statusCode == NOREGION){ /* if the U-proc has not mapped a region at virtAddr */
+		savedState->s_v0 = ERRORCONST;
+	}
+	else if (statusCode != READY){ /* if a write led to an error status */
+		savedState->s_v0 = statusCode * (-1); /* returning the negative of the status code */
+	}
+	else{
+		savedState->s_v0 = SUCCESSCONST;
+	}
+	switchUContext(savedState); /* return control back to the Current Process */
+}
+
 /* Internal function that handles SYSCALL events when the running process is executing in kernel-mode. This function's tasks include, but are not
 limited to, incrementing the value of the PC in the stored exception state (to avoid an infinite loop of SYSCALLs) and checking to see what SYSCALL
 number was requested so it can invoke an internal helper function to handle that specific SYSCALL. If an invalid SYSCALL number was provided
-(i.e., the SYSCALL number requested was not 9, 10 or 12), we invoke the internal function that handles phase 3 Program Traps. */ 
+(i.e., the SYSCALL number requested was not 9 through 28), we invoke the internal function that handles phase 3 Program Traps. */ 
 void sysTrapHandler(state_PTR savedState, support_t *curProcSupportStruct){
     /* declaring local variables */ 
     int sysNum; /* the number of the SYSCALL that we are addressing */
@@ -144,7 +482,7 @@ void sysTrapHandler(state_PTR savedState, support_t *curProcSupportStruct){
 
 	savedState->s_pc = savedState->s_pc + WORDLEN; /* increment the proc's PC to continue with the next instruction when it resumes running */
 
-	/* enumerating the sysNum values (9, 10 and 12) and passing control to the respective function to handle the SYSCALL request */
+	/* enumerating the sysNum values (9 through 28) and passing control to the respective function to handle the SYSCALL request */
 	switch (sysNum){ 
         case SYS9NUM: /* if the sysNum indicates a SYS9 event */
             terminateUProc(); /* invoking the internal function that handles SYS9 events */
@@ -152,12 +490,84 @@ void sysTrapHandler(state_PTR savedState, support_t *curProcSupportStruct){
         case SYS10NUM: /* if the sysNum indicates a SYS10 event */
             getTOD(savedState); /* invoking the internal function that handles SYS10 events */
 			
+		case SYS11NUM: /* if the sysNum indicates a SYS11 event */
+			/* a1 should contain the virtual address of the first character of the string to be printed */
+			/* a2 should contain the length of this string */
+			writeToDevice(PRNTINT, (char *) (savedState->s_a1), (int) (savedState->s_a2), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS11 events */
+
 		case SYS12NUM: /* if the sysNum indicates a SYS12 event */
 			/* a1 should contain the virtual address of the first character of the string to be transmitted */
 			/* a2 should contain the length of this string */
-			writeToTerminal((char *) (savedState->s_a1), (int) (savedState->s_a2), procASID, savedState); /* invoking the internal function that handles SYS12 events */	
+			writeToDevice(TERMINT, (char *) (savedState->s_a1), (int) (savedState->s_a2), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS12 events */	
+
+		case SYS13NUM: /* if the sysNum indicates a SYS13 event */
+			/* a1 should contain the virtual address of the buffer that the line is read into */
+			readTerminal((char *) (savedState->s_a1), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS13 events */
+
+		case SYS14NUM: /* if the sysNum indicates a SYS14 event */
+			/* a1 should contain the virtual address of the page the sector is read into */
+			/* a2 should contain the disk number and a3 the sector number */
+			diskTransfer(READ, (memaddr) (savedState->s_a1), (int) (savedState->s_a2), (int) (savedState->s_a3), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS14 events */
+
+		case SYS15NUM: /* if the sysNum indicates a SYS15 event */
+			/* a1 should contain the virtual address of the page written to the sector */
+			/* a2 should contain the disk number and a3 the sector number */
+			diskTransfer(WRITE, (memaddr) (savedState->s_a1), (int) (savedState->s_a2), (int) (savedState->s_a3), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS15 events */
+
+		case SYS16NUM: /* if the sysNum indicates a SYS16 event */
+			/* a1 should contain the virtual address of the page the block is read into */
+			/* a2 should contain the flash device number and a3 the block number */
+			flashBlockTransfer(READ, (memaddr) (savedState->s_a1), (int) (savedState->s_a2), (int) (savedState->s_a3), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS16 events */
+
+		case SYS17NUM: /* if the sysNum indicates a SYS17 event */
+			/* a1 should contain the virtual address of the page written to the block */
+			/* a2 should contain the flash device number and a3 the block number */
+			flashBlockTransfer(WRITE, (memaddr) (savedState->s_a1), (int) (savedState->s_a2), (int) (savedState->s_a3), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS17 events */
+
+		case SYS18NUM: /* if the sysNum indicates a SYS18 event */
+			/* a1 should contain the number of seconds the U-proc sleeps for */
+			delay((int) (savedState->s_a1), procASID, savedState); /* invoking the internal function that handles SYS18 events */
+
+		case SYS19NUM: /* if the sysNum indicates a SYS19 event */
+			/* a1 should contain the virtual address of the semaphore */
+			virtualSemOp(TRUE, (memaddr) (savedState->s_a1), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS19 events */
+
+		case SYS20NUM: /* if the sysNum indicates a SYS20 event */
+			/* a1 should contain the virtual address of the semaphore */
+			virtualSemOp(FALSE, (memaddr) (savedState->s_a1), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS20 events */
+
+		case SYS21NUM: /* if the sysNum indicates a SYS21 event */
+			/* a1 should contain the segment's key, a2 its number of pages and a3 the mode (SHMSHARED or SHMCOW) */
+			attachSegment((int) (savedState->s_a1), (int) (savedState->s_a2), (int) (savedState->s_a3), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS21 events */
+
+		case SYS22NUM: /* if the sysNum indicates a SYS22 event */
+			/* a1 should contain the segment's key */
+			detachSegment((int) (savedState->s_a1), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS22 events */
+
+		case SYS23NUM: /* if the sysNum indicates a SYS23 event */
+			/* a1 should contain the virtual address of the first byte to be pinned and a2 the number of bytes */
+			lockPages((memaddr) (savedState->s_a1), (int) (savedState->s_a2), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS23 events */
+
+		case SYS24NUM: /* if the sysNum indicates a SYS24 event */
+			/* a1 should contain the virtual address of the first byte to be unpinned and a2 the number of bytes */
+			unlockPages((memaddr) (savedState->s_a1), (int) (savedState->s_a2), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS24 events */
+
+		case SYS25NUM: /* if the sysNum indicates a SYS25 event */
+			/* a1 should contain the flash device number, a2 the first block to be mapped and a3 the number of blocks */
+			mapFlashBlocks((int) (savedState->s_a1), (int) (savedState->s_a2), (int) (savedState->s_a3), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS25 events */
+
+		case SYS26NUM: /* if the sysNum indicates a SYS26 event */
+			/* a1 should contain the virtual address at which the region is mapped */
+			syncFlashMapping((memaddr) (savedState->s_a1), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS26 events */
+
+		case SYS27NUM: /* if the sysNum indicates a SYS27 event */
+			/* a1 should contain the virtual address at which the region is mapped */
+			unmapFlashMapping((memaddr) (savedState->s_a1), curProcSupportStruct, savedState); /* invoking the internal function that handles SYS27 events */
+
+		case SYS28NUM: /* if the sysNum indicates a SYS28 event */
+			syncFlashCache(savedState); /* invoking the internal function that handles SYS28 events */
 			
-		default: /* the sysNum indicates a SYSCALL event whose number is not between 9 and 12 */
+		default: /* the sysNum indicates a SYSCALL event whose number is not handled by the support level */
 			programTrapHandler(); /* calling the phase 3 function that handles Program Traps */		
     }
 }
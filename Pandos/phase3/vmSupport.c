@@ -10,6 +10,129 @@
  * that is responsible for returning control back to a particular process. In 
  * short, this module is responsible for handling page faults and initializing
  * virtual memory in phase 3.
+ *
+ * Note that the Swap Pool semaphore is only held while the Pager inspects the
+ * Swap Pool table and reserves a frame. The frame is marked as being in transit
+ * (FRAMEBUSY) before the semaphore is released, and the (potentially long) flash
+ * operations are performed without it, so that page faults from U-procs using
+ * different flash devices are serviced concurrently. A U-proc that faults on a
+ * page that is currently in transit waits on that frame's own semaphore only.
+ *
+ * The module also implements the Pager's read-ahead. When a U-proc faults on
+ * the logical page that follows the last page it faulted on (or read ahead),
+ * the Pager reserves free frames for the next few logical pages and queues
+ * them for the read-ahead daemon, which reads them (from swap or from the
+ * U-proc's flash device) and maps them as each read completes. The number of pages read ahead
+ * for each U-proc grows while its prefetched pages are used and shrinks (down
+ * to zero, disabling read-ahead) when they are evicted without being referenced.
+ * The same daemon is used by test() to preload a U-proc's load image into the
+ * Swap Pool before the U-proc is launched (when PRELOADUPROCS is TRUE).
+ *
+ * Pages that lie entirely beyond the end of a U-proc's load image (i.e., its
+ * .bss pages) and the stack page have no meaningful contents on their first
+ * access, so the Pager satisfies the first page fault on such a page by
+ * zeroing the frame rather than reading the U-proc's flash device. The page
+ * is backed by swap only once it has been evicted for the first time.
+ *
+ * Pages are mapped with the D bit off until they are first written, at which
+ * point the resulting TLB-Modification exception is used to turn the D bit on
+ * and mark the frame as dirty; only dirty frames are written to swap when
+ * they are evicted. The page cleaner daemon, woken on every Pseudo-clock tick
+ * and whenever the Pager finds too few clean frames, writes back the dirty
+ * frames that are next in line for replacement, so that most page faults
+ * only need to read the missing page.
+ *
+ * Dirty pages that are evicted are first offered to the compressed page
+ * cache, a region of RAM (ZCACHEPAGES pages following the Swap Pool) that
+ * holds compressed copies of evicted pages. Pages are compressed by encoding
+ * runs of identical words (so that zero-filled and same-filled pages take
+ * two words) and are only cached if they compress to half a page or less.
+ * A page fault on a cached page is satisfied by decompressing it, without
+ * any flash I/O. When the cache runs low on space, the page cleaner writes
+ * the oldest cached pages back to swap.
+ *
+ * Each U-proc has a two-level Page Table: a page directory of PGDIRSIZE
+ * pointers, each to a table of ENTRIESPERPG Page Table entries. The first
+ * table is part of the U-proc's Support Structure, while the others are
+ * taken from a pool the first time the Pager handles a page fault on a page
+ * that they cover (the TLB-Refill handler maps pages with no table as
+ * invalid). A U-proc's address space consists of LOWPGMAX pages starting at
+ * KUSEG and STACKPGMAX stack pages growing down from the stack page; a page
+ * fault outside of these regions is treated as a Program Trap. A U-proc's
+ * stack starts out as a single page and grows on demand: a page fault on
+ * one of the STACKGAPPGS pages just below the current bottom of the stack
+ * grows the stack down to that page (as long as the U-proc's stack limit is
+ * not exceeded), and the new stack pages are zero-filled when first touched.
+ *
+ * U-procs that run the same load image share their .text pages. When the
+ * Pager reads a U-proc's aout header, it identifies the load image (without
+ * holding the Swap Pool lock) by a hash of the pages holding only .text,
+ * starting with the one holding the aout header; a load image whose hash
+ * matches one identified before shares its identifier only if their blocks
+ * compare equal, so images that differ anywhere in .text never share. The
+ * pages that hold only .text are made read-only (a store into them is
+ * treated as a Program Trap). A page fault on a .text page that another
+ * U-proc running the same image already has in the Swap Pool is satisfied by
+ * mapping that frame. Each frame keeps a reverse map of the U-procs sharing
+ * it besides its owner, so that every mapping is invalidated when the frame
+ * is evicted; when the owner releases a shared frame, one of the sharers
+ * becomes its owner instead.
+ *
+ * U-procs can also share memory through shared memory segments, which are
+ * named by a key and attached with SYS21 (and detached with SYS22). Each
+ * segment is mapped at the same logical pages in every U-proc that attaches
+ * it (a window of SHMWINDOWPGS pages just below the stack region), and its
+ * pages are zero-filled on their first access and swapped under the ASID of
+ * the U-proc that created it. A frame holding a segment
+ * page is owned by the segment's own Page Table entry, and every U-proc that
+ * maps the page is recorded in the frame's reverse map, so that the mappings
+ * are invalidated together when the frame is evicted. A U-proc may instead
+ * attach a segment copy-on-write: its first store into a segment page raises
+ * a TLB-Modification exception, and the Pager gives it a private copy of the
+ * page (through the compressed page cache or swap). A
+ * segment is destroyed when the last U-proc attaching it detaches it (or
+ * terminates).
+ *
+ * A U-proc's flash device only holds its load image. Evicted pages are
+ * written to a separate swap area of SWAPDEVCNT flash devices that follow the
+ * U-procs' own, divided into swap slots that are allocated independently of
+ * page numbers (each U-proc's slot for each page is recorded in pgSlot). A
+ * page that has a slot is read from it, and any other page from the load
+ * image. The slots are grouped into clusters of SWAPCLUSTER adjacent blocks,
+ * and consecutive clusters lie on consecutive swap devices, so that swap
+ * traffic is striped across the devices. The page cleaner moves the pages it
+ * writes in one pass to a run of adjacent slots in one cluster, and writes
+ * them back-to-back while holding the swap device. A U-proc's slots are
+ * reclaimed when it terminates (and a segment's when it is destroyed).
+ *
+ * A U-proc can pin up to PINQUOTA of its pages into the Swap Pool with SYS23
+ * (and unpin them with SYS24), and the support level pins the page holding
+ * a U-proc's buffer while the buffer is used for device I/O, or while
+ * copyIn() and copyOut() copy a service's arguments a page at a time
+ * through the frame's kernel address. Each frame has a pin count, and
+ * the Pager never selects a pinned frame for replacement.
+ * The number of pages pinned by U-procs is limited to PINFRAMEMAX, so that
+ * page faults can always be satisfied, and a U-proc that has pinned pages
+ * is never suspended by the load control.
+ *
+ * A U-proc can also map up to MMAPMAX ranges of blocks of a flash device
+ * (one of those following the swap devices) into its address space with
+ * SYS25. The regions are mapped in a window of MMAPWINDOWPGS pages just
+ * below the shared memory segment window, and the Pager reads their pages
+ * directly from the blocks they map (rather than from swap or the load
+ * image). Dirty pages are written back to those blocks when they are
+ * evicted, when the U-proc requests it with SYS26, and when the region is
+ * unmapped with SYS27 (or the U-proc terminates); they are never placed in
+ * the compressed page cache or written by the page cleaner.
+ *
+ * Finally, the module implements the Pager's load control (a medium-term
+ * scheduler). The Pager counts the page faults taken by each U-proc during
+ * every Pseudo-clock tick. When the total exceeds THRASHFAULTS, the U-proc
+ * with the most page faults is suspended at its next page fault: it writes
+ * back its dirty pages, releases all of its frames to the Swap Pool and waits
+ * until the page fault rate drops below RESUMEFAULTS (or another U-proc
+ * terminates) before it competes for frames again. At least one U-proc is
+ * always left running, so that the system makes progress.
  *  
  * Written by: Kollen Gruizenga and Jake Heyser
  ****************************************************************************/
@@ -24,15 +147,109 @@
 #include "../h/initial.h"
 #include "../h/initProc.h"
 #include "../h/vmSupport.h"
+#include "../h/deviceSupportDMA.h"
 #include "../h/sysSupport.h"
 #include "/usr/include/umps3/umps/libumps.h"
 
 /* function declarations */
-HIDDEN void flashOperation(int readOrWrite, int pid, memaddr frameAddress, int missingPgNum); /* function declaration for the function that is responsible for reading or writing to a flash device */
+HIDDEN int flashOperation(int readOrWrite, int devNo, memaddr frameAddress, int blockNum); /* function declaration for the function that is responsible for reading or writing to a flash device */
+HIDDEN int allocSlotRun(int cnt); /* function declaration for the function that allocates a run of adjacent swap slots */
+HIDDEN int assignSlot(int asid, int pgNo); /* function declaration for the function that makes sure that a page has a swap slot */
+HIDDEN void freeSlots(int asid, int firstPgNo, int cnt); /* function declaration for the function that frees the swap slots of a range of pages */
+HIDDEN int writePage(int asid, int pgNo, memaddr frameAddr); /* function declaration for the function that writes a page to its swap slot */
+HIDDEN int readPage(int asid, int pgNo, memaddr frameAddr); /* function declaration for the function that reads a page from swap or from its load image */
+HIDDEN void waitForWriteBack(int asid, int firstPgNo, int cnt); /* function declaration for the function that waits for the transfers of a range of pages to complete */
+HIDDEN void writeCluster(int firstSlot, int *burst, int *burstStatus, int cnt); /* function declaration for the function that writes a burst of frames to a run of adjacent swap slots */
+HIDDEN void unpinRange(int asid, int firstPgNo, int cnt); /* function declaration for the function that releases a U-proc's pins on a range of pages */
+HIDDEN int mmapFind(int asid, int pgNo); /* function declaration for the function that locates the mapped region holding a page */
+HIDDEN int syncRegion(int asid, int regionNo); /* function declaration for the function that writes a mapped region's dirty pages back to flash */
+HIDDEN int unmapRegion(support_t *supportStruct, int regionNo); /* function declaration for the function that unmaps a mapped region */
+HIDDEN int findTransitFrame(int asid, int pgNo); /* function declaration for the function that locates the frame (if any) that the given page is in transit to or from */
+HIDDEN int selectVictim(); /* function declaration for the function that selects the frame to satisfy a page fault */
+HIDDEN void releaseFrame(int frameNo); /* function declaration for the function that marks a frame as idle and wakes the processes waiting on it */
+HIDDEN void readAhead(support_t *supportStruct, int missingPgNo); /* function declaration for the function that queues the pages following a sequential page fault for read-ahead */
+HIDDEN int queueFrameRead(support_t *supportStruct, int pgNo, int prefetched); /* function declaration for the function that reserves a free frame for a page and queues it for the read-ahead daemon */
+HIDDEN void waitForTransit(int asid, int pgNo); /* function declaration for the function that waits for a page's flash transfer to complete */
+HIDDEN int recordImageBounds(support_t *supportStruct, unsigned int *aoutHdr); /* function declaration for the function that records the bounds of a U-proc's load image from its aout header */
+HIDDEN void identifyImage(support_t *supportStruct, int textPgCnt); /* function declaration for the function that identifies a U-proc's load image so that its .text pages can be shared */
+HIDDEN int sameImage(int asid, int other, int textPgCnt); /* function declaration for the function that determines whether two U-procs' load images have identical .text */
+HIDDEN int isZeroFillPage(support_t *supportStruct, int pgNo); /* function declaration for the function that determines whether a page fault can be satisfied by zeroing a frame */
+HIDDEN void zeroFrame(memaddr frameAddr); /* function declaration for the function that zeroes the contents of a frame */
+HIDDEN void accountEviction(int frameNo); /* function declaration for the function that adjusts a U-proc's read-ahead window when one of its frames is evicted */
+HIDDEN void checkWatermark(); /* function declaration for the function that wakes the page cleaner when too few frames are clean */
+HIDDEN void handleTlbMod(support_t *curProcSupportStruct, state_PTR savedState); /* function declaration for the function that handles TLB-Modification exceptions */
+HIDDEN void loadControl(); /* function declaration for the function that suspends or resumes U-procs based on the page fault rate */
+HIDDEN void resumeUProc(); /* function declaration for the function that resumes the U-proc that has been suspended the longest */
+HIDDEN void suspendUProc(support_t *supportStruct); /* function declaration for the function that releases a U-proc's frames and suspends it */
+HIDDEN void initPteTbl(pte_entry_t *pgTbl, int dirNo, int asid); /* function declaration for the function that initializes a table of Page Table entries */
+HIDDEN int allocPgTbl(support_t *supportStruct, int dirNo); /* function declaration for the function that allocates a table of Page Table entries on demand */
+HIDDEN pte_entry_t *findPte(support_t *supportStruct, int pgNo); /* function declaration for the function that locates a U-proc's Page Table entry for a logical page */
+HIDDEN int checkStackAccess(support_t *supportStruct, int pgNo); /* function declaration for the function that determines whether a page fault in the stack region is a legal access or stack growth */
+HIDDEN rmap_t *allocRmap(); /* function declaration for the function that allocates a reverse map entry */
+HIDDEN void freeRmap(rmap_t *r); /* function declaration for the function that returns a reverse map entry to the free list */
+HIDDEN void tagFrame(int frameNo, support_t *supportStruct, int pgNo); /* function declaration for the function that records whether a frame's page may be shared */
+HIDDEN int findSharedFrame(support_t *supportStruct, int pgNo); /* function declaration for the function that locates a frame holding a .text page that a U-proc may share */
+HIDDEN void unmapSharers(int frameNo); /* function declaration for the function that invalidates every mapping of a frame by U-procs other than its owner */
+HIDDEN void dropSharer(int frameNo, int asid); /* function declaration for the function that removes a U-proc's mappings of a frame it shares */
+HIDDEN void promoteSharer(int frameNo); /* function declaration for the function that makes one of a shared frame's sharers its owner */
+HIDDEN int addSharer(int frameNo, int asid, pte_entry_t *pte); /* function declaration for the function that maps a frame into a U-proc that shares it */
+HIDDEN void copySegmentPage(support_t *supportStruct, int pgNo, pte_entry_t *pte); /* function declaration for the function that gives a U-proc a private copy of a copy-on-write segment page */
+HIDDEN void shmUnmap(support_t *supportStruct, int segNo); /* function declaration for the function that detaches a shared memory segment from a U-proc */
+HIDDEN void shmDestroy(int segNo); /* function declaration for the function that frees a shared memory segment that no U-proc has attached */
+HIDDEN int runLength(unsigned int *page, int wordNo); /* function declaration for the function that measures a run of identical words in a page */
+HIDDEN int compressPage(unsigned int *page, unsigned int *dest); /* function declaration for the function that compresses a page */
+HIDDEN void decompressPage(unsigned int *src, unsigned int *page); /* function declaration for the function that decompresses a page */
+HIDDEN int zcacheFind(int asid, int pgNo); /* function declaration for the function that locates a page in the compressed page cache */
+HIDDEN void zcacheGather(int entryNo); /* function declaration for the function that copies a cached page's chunks into the scratch buffer */
+HIDDEN void zcacheDrop(int entryNo); /* function declaration for the function that removes a page from the compressed page cache */
+HIDDEN int zcacheStore(int asid, int pgNo, memaddr frameAddr); /* function declaration for the function that places an evicted page in the compressed page cache */
+HIDDEN int zcacheLoad(int asid, int pgNo, memaddr frameAddr); /* function declaration for the function that satisfies a page fault from the compressed page cache */
+HIDDEN void zcacheWriteBack(); /* function declaration for the function that writes the oldest cached pages back to flash */
+HIDDEN void copyChunk(char *dest, char *src, int len); /* function declaration for the function that copies bytes between two kernel addresses a word at a time where it can */
 
 /* declaring variables that are global to this module */
 int swapSem; /* mutual exclusion semaphore that controls access to the Swap Pool data structure */
 HIDDEN swap_t swapPoolTbl[MAXFRAMECNT]; /* the Swap Pool data structure/table */
+HIDDEN int nextFrameNo; /* the frame number most recently selected by the FIFO page replacement algorithm */
+HIDDEN int raNextPgNo[UPROCMAX + 1]; /* for each ASID, the logical page number that a sequential page fault is expected on next */
+HIDDEN int raWindow[UPROCMAX + 1]; /* for each ASID, the number of pages read ahead after a sequential page fault (zero when read-ahead is disabled) */
+HIDDEN int raSeqCnt[UPROCMAX + 1]; /* for each ASID, the number of consecutive sequential page faults taken while read-ahead is disabled */
+HIDDEN int raQueue[MAXFRAMECNT]; /* the circular queue of frame numbers that are waiting to be read by the read-ahead daemon */
+HIDDEN int raHead; /* the index in raQueue of the next frame number to be read by the read-ahead daemon */
+HIDDEN int raCount; /* the number of frame numbers in raQueue */
+HIDDEN int raQueueSem; /* synchronization semaphore that counts the number of frames waiting to be read by the read-ahead daemon */
+HIDDEN int cleanerSem; /* synchronization semaphore on which the page cleaner daemon waits to be woken */
+HIDDEN int cleanerPending; /* TRUE if the page cleaner daemon has been woken and has not yet started its next pass */
+HIDDEN int lcFaultCnt[UPROCMAX + 1]; /* for each ASID, the number of page faults taken during the current Pseudo-clock tick */
+HIDDEN int lcState[UPROCMAX + 1]; /* for each ASID, the U-proc's load control state (LCACTIVE, LCPENDING, LCSUSPENDED or LCEXITED) */
+HIDDEN int lcSuspendTick[UPROCMAX + 1]; /* for each ASID, the Pseudo-clock tick at which the U-proc was suspended */
+HIDDEN int lcResumeSem[UPROCMAX + 1]; /* for each ASID, the synchronization semaphore on which the suspended U-proc waits to be resumed */
+HIDDEN int lcTick; /* the number of Pseudo-clock ticks that the load control has observed */
+HIDDEN pte_entry_t pgTblPool[PGTBLPOOLSIZE][ENTRIESPERPG]; /* the pool of tables of Page Table entries that are allocated on demand */
+HIDDEN int pgTblOwner[PGTBLPOOLSIZE]; /* for each table in the pool, the ASID of the U-proc it is allocated to (or EMPTYFRAME if it is free) */
+int pgFaultCnt; /* the number of page faults handled by the Pager (kept alongside the nucleus' TLB statistics) */
+HIDDEN rmap_t rmapPool[RMAPPOOLSIZE]; /* the pool of reverse map entries */
+HIDDEN rmap_t *rmapFree_h; /* ptr to head of the free list of reverse map entries */
+HIDDEN shmseg_t shmSegTbl[SHMSEGMAX]; /* the table of shared memory segments */
+HIDDEN zcache_t zcacheTbl[ZENTRYCNT]; /* the compressed page cache's table */
+HIDDEN int zNextChunk[ZCHUNKCNT]; /* for each chunk, the chunk that follows it in its page's (or the free) list of chunks */
+HIDDEN int zFreeHead; /* the first chunk in the list of free chunks */
+HIDDEN int zFreeChunks; /* the number of chunks in the list of free chunks */
+HIDDEN int zSeqNo; /* the sequence number given to the next page placed in the compressed page cache */
+HIDDEN int zWriteSem; /* synchronization semaphore on which page faults on a page that the page cleaner is writing back wait */
+HIDDEN int zWaitCnt; /* the number of processes currently waiting on zWriteSem */
+HIDDEN int slotUsed[SWAPSLOTCNT]; /* for each swap slot, TRUE if the slot holds a page that was written to swap */
+HIDDEN int pgSlot[UPROCMAX + 1][SLOTMAPSIZE]; /* for each ASID, the swap slot that each of its pages was written to (or NOSLOT) */
+HIDDEN int pinPgCnt[UPROCMAX + 1]; /* for each ASID, the number of pages that the U-proc has pinned (or reserved for pinning) */
+HIDDEN int pinPgNo[UPROCMAX + 1][PINQUOTA]; /* for each ASID, the logical page numbers of the pages that the U-proc has pinned (or NOPAGE) */
+HIDDEN int pinFrameNo[UPROCMAX + 1][PINQUOTA]; /* for each ASID, the frames holding the pages that the U-proc has pinned */
+HIDDEN int pinTotal; /* the number of pages that all U-procs together have pinned (or reserved for pinning) */
+HIDDEN mmap_t mmapTbl[UPROCMAX + 1][MMAPMAX]; /* for each ASID, the flash regions that the U-proc has mapped */
+HIDDEN int swapNextCluster; /* the cluster of swap slots that the next allocation starts searching from */
+HIDDEN unsigned int zScratch[ZMAXWORDS]; /* the buffer in which pages are compressed or gathered before being decompressed */
+HIDDEN int imageSem; /* mutual exclusion semaphore that controls access to the image buffers and the table of identified load images */
+HIDDEN image_t imageTbl[UPROCMAX + 1]; /* for each ASID, the load image that the U-proc was identified as running */
+HIDDEN int nextImageId; /* the identifier given to the next load image that is not identical to one identified before */
 
 /* Function that turns interrupts in the Status register on or off, as indicated by the function's parameter. If the caller wishes to
 turn interrupts on, then the value 1 is passed into the function, whereas if the caller wishes to disable interrupts, then the value 0
@@ -59,124 +276,2416 @@ void mutex(int opCode, int *semaphore){
 	}
 }
 
-/* Function that is responsible for reading or writing to process pid's flash device/backing store. More specifically, this function
-performs five key steps. First off, the function gains mutual exclusion over the appropriate device's device register. Next, it writes
-the device's DATA0 field with the particular frame's starting address (as indicated by the parameter frameAddress). Then, the function
-writes the device's COMMAND field with the device block number and the command to read or write (as indicated by the parameter readOrWrite).
-Then, the function issues a SYS 5 with the appropriate parameters to block the I/O requesting process process until the operation
-completes before releasing mutual exclusion over the device's device register. */
-void flashOperation(int readOrWrite, int pid, memaddr frameAddress, int missingPgNum){
+/* Function that is responsible for reading or writing block blockNum of flash device devNo (either a U-proc's flash device or a swap
+device) without consulting the flash block cache. More specifically, the function builds a request whose DATA0 value is the particular
+frame's starting address (as indicated by the parameter frameAddress) and whose command is to read or write (as indicated by the
+parameter readOrWrite) the block blockNum, submits it to the device's request queue in the Nucleus, and issues a SYS 5 with the
+appropriate parameters to block the I/O requesting process until the device has performed it. Since the Nucleus issues each request
+once the previous one completes, no mutual exclusion over the device's device register is needed. The function returns the device's
+status code to the caller, since the caller is responsible for cleaning up the frame that was in transit if the read or write
+operation led to an error status. */
+int flashTransfer(int readOrWrite, int devNo, memaddr frameAddress, int blockNum){
 	/* declaring local variables */
-	devregarea_t *temp; /* device register area that we can use to read and write the process pid's flash device */
-	int index; /* the index in devreg (and in devSemaphores) of the flash device associated with process pid */
-	int blockNum; /* the appropriate block number of the flash device */
-	int statusCode; /* the status code from the device register associated with the device that corresponds to the highest-priority interrupt */
+	devreq_t req; /* the request submitted to flash device devNo's request queue */
+	int statusCode; /* the status code returned by the flash device */
 
-	/* initializing local variables, except for statusCode, which will be initialized later */
-	temp = (devregarea_t *) RAMBASEADDR; /* initialization of temp */		
-	index = ((FLASHINT - OFFSET) * DEVPERINT) + (pid - 1); /* initializing the index in devreg (and in devSemaphores) of process pid's flash device/backing store */
-	blockNum = missingPgNum; /* initializing the device block number that we will place in the COMMAND field of the correct flash device later on */
-
-	mutex(TRUE, (int *) &(devSemaphores[index])); /* calling the function that gains mutual exclusion exclusion over process pid's flash device's device register */
-	temp->devreg[index].d_data0 = frameAddress; /* writing the flash device's DATA0 field with the selected frame number's starting address */
-	setInterrupts(FALSE); /* calling the function that disables interrupts in order to write the COMMAND field and issue the SYS 5 atomically */
-	
+	req.r_data0 = frameAddress; /* the device's DATA0 field is written with the selected frame's starting address */
 	if (readOrWrite == TRUE){ /* if the caller wishes to read from the flash device */
-		temp->devreg[index].d_command = READBLK | (blockNum << BLKNUMSHIFT); /* writing the device's COMMAND field with the device block number and the command to read */
+		req.r_command = READBLK | (blockNum << BLKNUMSHIFT); /* the device's COMMAND field is written with the device block number and the command to read */
 	}
 	else{ /* the caller wishes to write to the flash device */
-		temp->devreg[index].d_command = WRITEBLK | (blockNum << BLKNUMSHIFT); /* writing the device's COMMAND field with the device block number and the command to write */
+		req.r_command = WRITEBLK | (blockNum << BLKNUMSHIFT); /* the device's COMMAND field is written with the device block number and the command to write */
 	}
 
-	SYSCALL(SYS5NUM, LINE4, (pid - 1), readOrWrite); /* issuing the SYS 5 call to block the I/O requesting process until the operation completes */
+	setInterrupts(FALSE); /* calling the function that disables interrupts in order to submit the request and issue the SYS 5 atomically */
+	reqSubmit(FLASHINT, devNo, &req); /* calling the Nucleus function that queues the request (issuing it if the device is idle) */
+	statusCode = SYSCALL(SYS5NUM, LINE4, devNo, readOrWrite); /* issuing the SYS 5 call to block the I/O requesting process until the operation completes */
 	setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
-	statusCode = temp->devreg[index].d_status; /* setting the status code from the device register associated with process pid's flash device */
-	mutex(FALSE, (int *) &(devSemaphores[index])); /* calling the function that releases mutual exclusion over process pid's flash device's device register */
-	
-	if (statusCode != READY){ /* if the read or write operation led to an error status */
-		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to make sure we release mutual exclusion over the Swap Pool table */
-		programTrapHandler(); /* invoking the function that handles program traps in phase 3 */
+	return statusCode; /* returning the status code so that the caller can determine if the read or write operation led to an error status */
+}
+
+/* Function that is responsible for the Pager's reads and writes of block blockNum of flash device devNo. A read of a block that the
+flash block cache holds (which may be newer than the block on flash) is satisfied from the cache, while a write discards any copy the
+cache holds, since the page being written is newer still. Blocks of the swap devices are never in the cache. Otherwise, the function
+calls flashTransfer() to perform the operation, and returns the device's status code to the caller. */
+int flashOperation(int readOrWrite, int devNo, memaddr frameAddress, int blockNum){
+	if (!ISSWAPDEV(devNo)){ /* if the block may be in the flash block cache */
+		if (readOrWrite == READ){
+			if (bcacheLookup(devNo, blockNum, frameAddress) == TRUE){ /* calling the function in deviceSupportDMA.c that copies the block out of the cache (if it is there) */
+				return READY;
+			}
+		}
+		else{
+			bcacheDiscard(devNo, blockNum); /* calling the function in deviceSupportDMA.c that drops the cache's copy of the block */
+		}
 	}
+	return flashTransfer(readOrWrite, devNo, frameAddress, blockNum); /* calling the function that performs the operation on the device */
 }
 
-/* Function that initializes the Swap Pool table and the Swap Pool semaphore (i.e., the variables that are global
-to this module). Since the Swap Pool semaphore is used for mutual exclusion, the function initializes the semaphore to 1,
-and the function initializes every entry's ASID in the Swap Pool table to -1, since none of the frames in the Swap Pool
-are curretly occupied. */
-void initSwapStructs(){
-	swapSem = 1; /* initializing the Swap Pool semaphore to 1, since it will be used for the purpose of mutual exclusion */
+/* Function that returns the first of cnt adjacent free swap slots within one cluster, marking them as in use, or NOSLOT if no cluster
+has cnt adjacent free slots. The search starts at the cluster following the one last allocated from, so that consecutive allocations
+are spread across the swap devices. Note that the caller must hold mutual exclusion over the Swap Pool table. */
+int allocSlotRun(int cnt){
+	/* declaring local variables */
+	int i; /* the number of clusters examined */
+	int cluster; /* the cluster being examined */
+	int slot; /* the slot being examined */
+	int runStart; /* the first slot of the current run of free slots */
 
-	/* initializing the Swap Pool table */
+	for (i = 0; i < SWAPCLUSTERCNT; i++){
+		cluster = (swapNextCluster + i) % SWAPCLUSTERCNT;
+		runStart = cluster * SWAPCLUSTER;
+		for (slot = cluster * SWAPCLUSTER; slot < (cluster + 1) * SWAPCLUSTER; slot++){
+			if (slotUsed[slot] == TRUE){ /* if the slot is in use, a run of free slots can only start after it */
+				runStart = slot + 1;
+			}
+			else if (slot - runStart + 1 == cnt){ /* if the run of free slots is long enough */
+				for (slot = runStart; slot < runStart + cnt; slot++){
+					slotUsed[slot] = TRUE; /* marking the run as in use */
+				}
+				swapNextCluster = (cluster + 1) % SWAPCLUSTERCNT; /* the next allocation starts on the following cluster (and swap device) */
+				return runStart;
+			}
+		}
+	}
+	return NOSLOT;
+}
+
+/* Function that makes sure that page pgNo of the U-proc whose ASID is asid has a swap slot, allocating one if it has none. The function
+returns the page's swap slot, or NOSLOT if the swap area is full. Note that the caller must hold mutual exclusion over the Swap Pool
+table. */
+int assignSlot(int asid, int pgNo){
+	if ((pgSlot[asid][pgNo] == NOSLOT) && (mmapFind(asid, pgNo) == NOREGION)){ /* if the page has never been written to swap (pages of mapped regions are written to the flash they map instead) */
+		pgSlot[asid][pgNo] = allocSlotRun(1); /* calling the internal helper function to allocate a single slot */
+	}
+	return pgSlot[asid][pgNo];
+}
+
+/* Function that frees the swap slots of the cnt pages of the U-proc whose ASID is asid starting at page firstPgNo. Note that the caller
+must hold mutual exclusion over the Swap Pool table and that none of the pages may be in transit. */
+void freeSlots(int asid, int firstPgNo, int cnt){
+	int pgNo;
+
+	for (pgNo = firstPgNo; pgNo < firstPgNo + cnt; pgNo++){
+		if (pgSlot[asid][pgNo] != NOSLOT){ /* if the page has a swap slot */
+			slotUsed[pgSlot[asid][pgNo]] = FALSE; /* returning the slot to the swap area */
+			pgSlot[asid][pgNo] = NOSLOT;
+		}
+	}
+}
+
+/* Function that writes the page at address frameAddr to the swap slot of page pgNo of the U-proc whose ASID is asid, which the caller
+must have assigned with assignSlot() before releasing mutual exclusion over the Swap Pool table (or, if the page belongs to a mapped
+region, to the flash block that it maps). The function returns the device's status code, or SWAPFULL if the page has no swap slot. */
+int writePage(int asid, int pgNo, memaddr frameAddr){
+	int slot;
+	int regionNo; /* the mapped region holding the page (NOREGION if the page is not mapped) */
+
+	regionNo = mmapFind(asid, pgNo);
+	if (regionNo != NOREGION){ /* if the page belongs to a mapped region */
+		return flashOperation(WRITE, mmapTbl[asid][regionNo].devNo, frameAddr, mmapTbl[asid][regionNo].firstBlock + ((pgNo - MMAPBASEPGNO) % MMAPPGMAX)); /* calling the internal helper function to write the page to the block it maps */
+	}
+	slot = pgSlot[asid][pgNo];
+	if (slot == NOSLOT){ /* if no swap slot could be assigned to the page */
+		return SWAPFULL;
+	}
+	return flashOperation(WRITE, SLOTTODEV(slot), frameAddr, SLOTTOBLOCK(slot)); /* calling the internal helper function to write the page to its swap slot */
+}
+
+/* Function that reads page pgNo of the U-proc whose ASID is asid into the frame at address frameAddr: from the flash block it maps if
+the page belongs to a mapped region, from its swap slot if the page has been written to swap, or otherwise from the U-proc's load image
+on its own flash device. The function returns the device's status code. Note that the page must be in transit (so that neither its
+swap slot nor its region changes). */
+int readPage(int asid, int pgNo, memaddr frameAddr){
+	int slot;
+	int regionNo; /* the mapped region holding the page (NOREGION if the page is not mapped) */
+
+	regionNo = mmapFind(asid, pgNo);
+	if (regionNo != NOREGION){ /* if the page belongs to a mapped region */
+		return flashOperation(READ, mmapTbl[asid][regionNo].devNo, frameAddr, mmapTbl[asid][regionNo].firstBlock + ((pgNo - MMAPBASEPGNO) % MMAPPGMAX)); /* calling the internal helper function to read the page from the block it maps */
+	}
+	slot = pgSlot[asid][pgNo];
+	if (slot != NOSLOT){ /* if the page has been written to swap */
+		return flashOperation(READ, SLOTTODEV(slot), frameAddr, SLOTTOBLOCK(slot)); /* calling the internal helper function to read the page from its swap slot */
+	}
+	return flashOperation(READ, asid - 1, frameAddr, pgNo); /* calling the internal helper function to read the page from the U-proc's load image */
+}
+
+/* Function that waits until none of the cnt pages of the U-proc whose ASID is asid starting at page firstPgNo is being written to (or
+read from) swap, whether from a frame or from the compressed page cache, so that their swap slots can be freed. Note that the caller
+must hold mutual exclusion over the Swap Pool table. */
+void waitForWriteBack(int asid, int firstPgNo, int cnt){
+	/* declaring local variables */
+	int busy; /* TRUE if the function waited for a transfer during its last pass */
+	int frameNo;
+	int i;
+
+	busy = TRUE;
+	while (busy == TRUE){
+		busy = FALSE;
+		for (frameNo = 0; frameNo < MAXFRAMECNT; frameNo++){
+			if ((swapPoolTbl[frameNo].frameState == FRAMEBUSY)
+				&& (((swapPoolTbl[frameNo].asid == asid) && (swapPoolTbl[frameNo].pgNo >= firstPgNo) && (swapPoolTbl[frameNo].pgNo < firstPgNo + cnt))
+				|| ((swapPoolTbl[frameNo].evictAsid == asid) && (swapPoolTbl[frameNo].evictPgNo >= firstPgNo) && (swapPoolTbl[frameNo].evictPgNo < firstPgNo + cnt)))){ /* if one of the pages is in transit to or from the frame */
+				swapPoolTbl[frameNo].waitCnt++; /* registering the calling process as a waiter on the frame */
+				mutex(FALSE, (int *) &swapSem); /* releasing mutual exclusion over the Swap Pool table while we wait */
+				mutex(TRUE, (int *) &(swapPoolTbl[frameNo].frameSem)); /* performing a P operation on the frame's synchronization semaphore until its transfer completes */
+				mutex(TRUE, (int *) &swapSem); /* regaining mutual exclusion over the Swap Pool table */
+				busy = TRUE;
+			}
+		}
+		for (i = 0; i < ZENTRYCNT; i++){
+			if ((zcacheTbl[i].state == ZWRITING) && (zcacheTbl[i].asid == asid) && (zcacheTbl[i].pgNo >= firstPgNo) && (zcacheTbl[i].pgNo < firstPgNo + cnt)){ /* if one of the pages is being written from the compressed page cache */
+				zWaitCnt++; /* registering the calling process as a waiter on the write */
+				mutex(FALSE, (int *) &swapSem); /* releasing mutual exclusion over the Swap Pool table while we wait */
+				mutex(TRUE, (int *) &zWriteSem); /* performing a P operation on the write's synchronization semaphore until it completes */
+				mutex(TRUE, (int *) &swapSem); /* regaining mutual exclusion over the Swap Pool table */
+				busy = TRUE;
+			}
+		}
+	}
+}
+
+/* Function that searches the Swap Pool table for a frame that is in transit to or from a flash device on behalf of the page with
+logical page number pgNo belonging to the U-proc whose ASID is asid. A page is in transit either when it is being read into a frame
+or when it is being written out of a frame that was selected as a victim. The function returns the number of such a frame, or NOFRAME
+if the page is not in transit. Note that the caller must hold mutual exclusion over the Swap Pool table. */
+int findTransitFrame(int asid, int pgNo){
 	int i;
 	for (i = 0; i < MAXFRAMECNT; i++){
-		swapPoolTbl[i].asid = EMPTYFRAME; /* initializing the ASID to -1, since all frames are currently unoccupied */
+		if (swapPoolTbl[i].frameState == FRAMEBUSY){ /* if frame i has a flash transfer in progress */
+			if ((swapPoolTbl[i].asid == asid) && (swapPoolTbl[i].pgNo == pgNo)){ /* if the page is being read into frame i */
+				return i;
+			}
+			if ((swapPoolTbl[i].evictAsid == asid) && (swapPoolTbl[i].evictPgNo == pgNo)){ /* if the page is being written out of frame i */
+				return i;
+			}
+		}
 	}
+	return NOFRAME; /* the page is not in transit */
 }
 
-/* Function that returns control back to a particular process whose processor state is returnState. This function is used
-primarily as a debugging function. */
-void switchUContext(state_PTR returnState){
-	LDST(returnState); /* returning control back to the desired process */
+/* Function that selects a frame from the Swap Pool to satisfy a page fault using Pandos' FIFO page replacement algorithm. Frames that
+are in transit are skipped over, since another process is currently reading or writing them, and so are pinned frames. Since each
+U-proc may have at most one page fault outstanding and the number of pinned pages is bounded by PINFRAMEMAX, there is always at least
+one idle frame that is not pinned; nevertheless, should every frame be in transit or pinned, the function releases the Swap Pool semaphore and waits for a Pseudo-clock tick before looking again.
+Note that the caller must hold mutual exclusion over the Swap Pool table. */
+int selectVictim(){
+	int i;
+	while (TRUE){
+		for (i = 0; i < MAXFRAMECNT; i++){
+			nextFrameNo = (nextFrameNo + 1) % MAXFRAMECNT; /* advancing to the next frame, as determined by Pandos' FIFO page replacement algorithm */
+			if ((swapPoolTbl[nextFrameNo].frameState == FRAMEIDLE) && (swapPoolTbl[nextFrameNo].pinCnt == 0)){ /* if the frame is neither in transit nor pinned */
+				return nextFrameNo;
+			}
+		}
+		mutex(FALSE, (int *) &swapSem); /* releasing mutual exclusion over the Swap Pool table so that the transfers in progress can complete */
+		SYSCALL(SYS7NUM, 0, 0, 0); /* waiting for the next Pseudo-clock tick before searching the Swap Pool table again */
+		mutex(TRUE, (int *) &swapSem); /* regaining mutual exclusion over the Swap Pool table */
+	}
 }
 
-/* Function that handles page faults that are passed up by the Nucleus. Note that this function utilizes a FIFO page replacement
-algorithm. Now, more specifically, the function obtains a pointer to the Current Process' Support Structure, determines the cause
-of the TLB exception, and then, if the cause is a TLB-Modification exception, passes control to the phase 3 function that handles
-Program Traps. Next, the function gains mutual exclusion over the Swap Pool table, determines the missing page number, selects
-a frame from the Swap Pool using a FIFO page replacement algorithm to satisfy the page fault, and determines if the selected frame
-is occupied. If it is occupied, the function then updates the correct process' Page Table, updates the TLB (if needed), and then
-updates the correct process' backing store. Next, the function reads the contents of the Current Process' backing store's correct logical
-page into the frame previously selected, updates the Swap Pool table, updates the Current Process' Page Table, and then updates the
-TLB. Finally, the function releases mutual exclusion over the Swap Pool table before returning control back to the Current Process
-to retry the instruction that caused the page fault. */
-void vmTlbHandler(){
+/* Function that marks the frame frameNo as no longer being in transit and unblocks every process that was waiting for the frame's
+flash transfer to complete. Note that the caller must hold mutual exclusion over the Swap Pool table. */
+void releaseFrame(int frameNo){
+	swapPoolTbl[frameNo].frameState = FRAMEIDLE; /* the frame no longer has a flash transfer in progress */
+	swapPoolTbl[frameNo].evictAsid = EMPTYFRAME; /* there is no longer a page being written out of the frame */
+	while (swapPoolTbl[frameNo].waitCnt > 0){ /* while there is a process waiting for the frame's flash transfer to complete */
+		swapPoolTbl[frameNo].waitCnt--; /* decrementing the number of processes waiting on the frame */
+		mutex(FALSE, (int *) &(swapPoolTbl[frameNo].frameSem)); /* performing a V operation on the frame's synchronization semaphore to unblock one waiting process */
+	}
+}
+
+/* Function that reserves an unoccupied, idle frame for logical page pgNo of the U-proc whose Support Structure is supportStruct and
+places the frame on the read-ahead daemon's queue, so that the page is read from the U-proc's flash device and mapped without the U-proc
+waiting for it. The parameter prefetched indicates whether the page is being read speculatively (and should therefore count towards
+the U-proc's read-ahead window when it is evicted). The table that holds the page's Page Table entry is allocated if necessary. The
+function returns the reserved frame number, or NOFRAME if there are no unoccupied frames left in the Swap Pool (or no table could be
+allocated), in which case nothing is queued. Note that the caller must hold mutual exclusion over the
+Swap Pool table. */
+int queueFrameRead(support_t *supportStruct, int pgNo, int prefetched){
+	int frameNo;
+
+	if ((findPte(supportStruct, pgNo) == (pte_entry_t *) NULL) && (allocPgTbl(supportStruct, pgNo / ENTRIESPERPG) == FALSE)){ /* if there is no table to hold the page's Page Table entry */
+		return NOFRAME;
+	}
+
+	/* searching for an unoccupied frame that is not in transit */
+	frameNo = 0;
+	while ((frameNo < MAXFRAMECNT) && ((swapPoolTbl[frameNo].asid != EMPTYFRAME) || (swapPoolTbl[frameNo].frameState != FRAMEIDLE))){
+		frameNo++;
+	}
+	if (frameNo == MAXFRAMECNT){ /* if there are no free frames left in the Swap Pool */
+		return NOFRAME;
+	}
+
+	/* reserving the frame for page pgNo and placing it on the read-ahead daemon's queue */
+	swapPoolTbl[frameNo].frameState = FRAMEBUSY; /* marking the frame as in transit, so that no page fault selects it */
+	swapPoolTbl[frameNo].evictAsid = EMPTYFRAME; /* no page is being written out of the frame */
+	swapPoolTbl[frameNo].asid = supportStruct->sup_asid; /* updating the ASID field for the frame's entry in the Swap Pool table */
+	swapPoolTbl[frameNo].pgNo = pgNo; /* updating the page number field for the frame's entry in the Swap Pool table */
+	swapPoolTbl[frameNo].ownerProc = findPte(supportStruct, pgNo); /* updating the ownerProc field for the frame's entry in the Swap Pool table */
+	swapPoolTbl[frameNo].prefetched = prefetched; /* recording whether the frame's page is being read speculatively */
+	tagFrame(frameNo, supportStruct, pgNo); /* calling the internal helper function to record whether the frame's page may be shared */
+	swapPoolTbl[frameNo].segNo = NOSEG; /* pages are only read ahead from the U-proc's own load image */
+	raQueue[(raHead + raCount) % MAXFRAMECNT] = frameNo; /* appending the frame to the tail of the read-ahead queue */
+	raCount++;
+	mutex(FALSE, (int *) &raQueueSem); /* performing a V operation on the read-ahead queue's semaphore to wake the read-ahead daemon */
+	return frameNo;
+}
+
+/* Function that blocks the calling process for as long as logical page pgNo of the U-proc whose ASID is asid is in transit to or
+from a frame in the Swap Pool. The caller registers itself as a waiter on the frame and performs a P operation on the frame's
+synchronization semaphore, which is V'd once the frame's flash transfer completes. Note that the caller must hold mutual exclusion
+over the Swap Pool table, which is released while the caller waits and is held again when the function returns. */
+void waitForTransit(int asid, int pgNo){
+	int frameNo;
+
+	frameNo = findTransitFrame(asid, pgNo);
+	while (frameNo != NOFRAME){ /* while the page is in transit to or from a frame */
+		swapPoolTbl[frameNo].waitCnt++; /* registering the calling process as a waiter on the frame */
+		mutex(FALSE, (int *) &swapSem); /* releasing mutual exclusion over the Swap Pool table while we wait */
+		mutex(TRUE, (int *) &(swapPoolTbl[frameNo].frameSem)); /* performing a P operation on the frame's synchronization semaphore until its transfer completes */
+		mutex(TRUE, (int *) &swapSem); /* regaining mutual exclusion over the Swap Pool table */
+		frameNo = findTransitFrame(asid, pgNo);
+	}
+}
+
+/* Function that records, in the Support Structure supportStruct, the number of logical pages spanned by the .text and .data sections of
+the U-proc's load image, as determined from the size and location of the .data section in the aout header pointed to by aoutHdr. The
+end of the .data section is rounded up to a whole page, and the shared memory segment window and the stack region are never considered
+part of the load image. The function returns the number of pages that lie entirely below the .data section (i.e., that hold only
+.text), which identifyImage() uses to identify the load image. Note that the caller must hold mutual exclusion over the Swap Pool
+table. */
+int recordImageBounds(support_t *supportStruct, unsigned int *aoutHdr){
+	int imagePgCnt;
+
+	imagePgCnt = ((aoutHdr[AOUTDATAVADDR] - KUSEG) + aoutHdr[AOUTDATAFILESZ] + (PAGESIZE - 1)) / PAGESIZE; /* rounding the end of the .data section in the load image up to a whole page */
+	supportStruct->sup_imagePgCnt = MIN(imagePgCnt, MMAPBASEPGNO); /* the mapped region and shared memory segment windows and the stack region are never part of the load image */
+	return MIN((aoutHdr[AOUTDATAVADDR] - KUSEG) / PAGESIZE, supportStruct->sup_imagePgCnt); /* the pages below the page holding the start of .data hold only .text */
+}
+
+/* Function that identifies the load image of the U-proc whose Support Structure is supportStruct, whose first textPgCnt pages (starting
+with the one holding the aout header) hold only .text, so that it can share those pages with the U-procs whose load image is identical.
+The function reads the .text blocks from the U-proc's flash device and hashes them (FNV-1a). A load image that was already identified
+with the same hash and number of .text pages is only taken to be the same one if sameImage() finds their blocks to be identical, so
+that a hash collision never maps another U-proc's code; otherwise the load image is given a new identifier. The flash reads are
+performed without mutual exclusion over the Swap Pool table, which the caller must hold on entry and which the function releases until
+it records the identifier and the number of .text pages in supportStruct. If a block cannot be read, the U-proc's pages are never
+shared. */
+void identifyImage(support_t *supportStruct, int textPgCnt){
 	/* declaring local variables */
-	state_PTR savedState; /* a pointer to the saved exception state responsible for the TLB exception */
-	support_t *curProcSupportStruct; /* a pointer to the Current Process' Support Structure */
-	memaddr frameAddr; /* the address of the frame selected by the page replacement algorithm to satisfy the page fault */
-	int exceptionCode; /* the exception code */
-	int missingPgNo; /* the missing page number, as indicated in the saved exception state's EntryHi field */
-	HIDDEN int frameNo; /* the frame number used to satisfy a page fault */
+	int asid; /* the ASID of the U-proc whose load image is being identified */
+	unsigned int *textPg; /* the image buffer into which the U-proc's .text blocks are read */
+	unsigned int hash; /* the hash of the pages holding only .text */
+	int imageId; /* the identifier given to the load image */
+	int pgNo;
+	int other; /* the ASID of the U-proc whose load image is being compared */
+	int i;
 
-	curProcSupportStruct = (support_t *) SYSCALL(SYS8NUM, 0, 0, 0); /* obtaining a pointer to the Current Process' Support Structure */
-	savedState = &(curProcSupportStruct->sup_exceptState[PGFAULTEXCEPT]); /* initializing savedState to the state found in the Current Process' Support Structure for TLB exceptions */
-	exceptionCode = ((savedState->s_cause) & GETEXCEPCODE) >> CAUSESHIFT; /* initializing the exception code so that it matches the exception code stored in the .ExcCode field in the Cause register */
+	asid = supportStruct->sup_asid;
+	textPg = (unsigned int *) IMAGEBUFADDR;
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table while flash is read */
+	mutex(TRUE, (int *) &imageSem); /* calling the internal helper function to gain mutual exclusion over the image buffers and the table of identified load images */
 
-	if (exceptionCode == TLBMODEXCCODE){ /* if the exception code indicates that a TLB-Modification exception occurred */
-		programTrapHandler(); /* invoking the function that handles Program Traps in phase 3 */
+	hash = FNVOFFSET;
+	for (pgNo = 0; pgNo < textPgCnt; pgNo++){
+		if (flashOperation(READ, asid - 1, (memaddr) textPg, pgNo) != READY){ /* if the .text page could not be read, the load image cannot be identified */
+			textPgCnt = 0;
+		}
+		for (i = 0; (pgNo < textPgCnt) && (i < PAGESIZE / WORDLEN); i++){
+			hash = (hash ^ textPg[i]) * FNVPRIME; /* folding each word of the .text page into the hash */
+		}
+	}
+
+	imageId = NOIMAGE;
+	for (other = 1; (other <= UPROCMAX) && (textPgCnt > 0) && (imageId == NOIMAGE); other++){
+		if ((other != asid) && (imageTbl[other].textPgCnt == textPgCnt) && (imageTbl[other].hash == hash)
+			&& (sameImage(asid, other, textPgCnt) == TRUE)){ /* if the U-proc's load image is identical to the one U-proc other runs */
+			imageId = imageTbl[other].imageId;
+		}
+	}
+	if ((textPgCnt > 0) && (imageId == NOIMAGE)){ /* if no identical load image has been identified before */
+		imageId = nextImageId;
+		nextImageId++;
+	}
+	imageTbl[asid].hash = hash;
+	imageTbl[asid].textPgCnt = textPgCnt;
+	imageTbl[asid].imageId = imageId;
+
+	mutex(FALSE, (int *) &imageSem); /* calling the internal helper function to release mutual exclusion over the image buffers and the table of identified load images */
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to regain mutual exclusion over the Swap Pool table */
+	supportStruct->sup_imageId = imageId;
+	supportStruct->sup_textPgCnt = textPgCnt; /* publishing the number of .text pages, which makes the U-proc's .text pages read-only and shareable */
+}
+
+/* Function that compares the first textPgCnt blocks of the flash devices holding the load images of the U-procs whose ASIDs are asid and
+other, reading them into the two image buffers. The function returns TRUE if every block was read and the blocks are identical, and
+FALSE otherwise. Note that the caller must hold mutual exclusion over the image buffers (but not over the Swap Pool table). */
+int sameImage(int asid, int other, int textPgCnt){
+	/* declaring local variables */
+	unsigned int *ownPg; /* the image buffer into which the block of asid's load image is read */
+	unsigned int *otherPg; /* the image buffer into which the block of other's load image is read */
+	int same; /* TRUE as long as the blocks compared so far are identical */
+	int pgNo;
+	int i;
+
+	ownPg = (unsigned int *) IMAGEBUFADDR;
+	otherPg = (unsigned int *) (IMAGEBUFADDR + PAGESIZE);
+	same = TRUE;
+	for (pgNo = 0; (pgNo < textPgCnt) && (same == TRUE); pgNo++){
+		if ((flashOperation(READ, asid - 1, (memaddr) ownPg, pgNo) != READY) || (flashOperation(READ, other - 1, (memaddr) otherPg, pgNo) != READY)){ /* if either block could not be read */
+			same = FALSE;
+		}
+		for (i = 0; (same == TRUE) && (i < PAGESIZE / WORDLEN); i++){
+			same = (ownPg[i] == otherPg[i]);
+		}
+	}
+	return same;
+}
+
+/* Function that determines whether logical page pgNo of the U-proc whose Support Structure is supportStruct has no meaningful contents
+on its flash device, in which case a page fault on it can be satisfied by zeroing a frame. This is the case for the stack pages and for
+every page beyond the end of the load image (once the aout header has been read), as long as the page has never been written to flash
+(i.e., evicted) before. The function returns TRUE if the page can be zero-filled and FALSE otherwise. */
+int isZeroFillPage(support_t *supportStruct, int pgNo){
+	pte_entry_t *pte;
+
+	pte = findPte(supportStruct, pgNo);
+	if ((pte != (pte_entry_t *) NULL) && (((pte->entryLO) & PTEBACKEDBITON) != ALLOFF)){ /* if the page has been written to flash before */
+		return FALSE;
+	}
+	if (mmapFind(supportStruct->sup_asid, pgNo) != NOREGION){ /* if the page belongs to a mapped region, whose contents are on the flash it maps */
+		return FALSE;
+	}
+	if (pgNo >= LOWPGMAX){ /* if the page is in the stack region */
+		return TRUE;
+	}
+	return ((supportStruct->sup_imagePgCnt != IMAGEUNKNOWN) && (pgNo >= supportStruct->sup_imagePgCnt)); /* the page is zero-filled if it lies beyond the end of the load image */
+}
+
+/* Function that sets every word of the frame whose starting address is frameAddr to zero. */
+void zeroFrame(memaddr frameAddr){
+	int i;
+	for (i = 0; i < PAGESIZE / WORDLEN; i++){
+		((int *) frameAddr)[i] = 0;
+	}
+}
+
+/* Function that adjusts the read-ahead window of the U-proc whose page occupies frame frameNo just before that page is evicted. If
+the page was read ahead, the function checks the page's software reference bit: a referenced page means that read-ahead is paying off
+for the U-proc, so its window is widened (up to READAHEADMAX pages), whereas an unreferenced page means that the read was wasted, so
+its window is halved. Once a U-proc's window reaches zero, read-ahead is disabled for it. Note that the caller must hold mutual
+exclusion over the Swap Pool table. */
+void accountEviction(int frameNo){
+	/* declaring local variables */
+	int asid; /* the ASID of the U-proc whose page occupies the frame */
+
+	asid = swapPoolTbl[frameNo].asid; /* initializing asid to the ASID of the U-proc whose page occupies the frame */
+	if ((asid == EMPTYFRAME) || (swapPoolTbl[frameNo].prefetched == FALSE)){ /* if the frame is unoccupied or its page was read in on demand */
+		return;
+	}
+
+	if (((swapPoolTbl[frameNo].ownerProc->entryLO) & PTEREFBITON) != ALLOFF){ /* if the prefetched page was referenced while it was resident */
+		raWindow[asid] = MIN(raWindow[asid] + 1, READAHEADMAX); /* widening the U-proc's read-ahead window */
+	}
+	else{ /* the prefetched page was never used */
+		raWindow[asid] = raWindow[asid] / 2; /* halving the U-proc's read-ahead window, which eventually disables read-ahead */
+	}
+	swapPoolTbl[frameNo].prefetched = FALSE; /* the page is leaving the frame, so the frame no longer holds a prefetched page */
+}
+
+/* Function that implements the Pager's read-ahead policy after the page fault on logical page missingPgNo of the U-proc whose Support
+Structure is supportStruct has been satisfied. If the fault was sequential (i.e., it was on the page the U-proc was expected to fault
+on next), the function reserves free frames for up to raWindow of the following logical pages that are neither valid, in transit nor
+in the compressed page cache,
+and places each reserved frame on the read-ahead daemon's queue. Only unoccupied frames are used, so read-ahead never evicts a page.
+While read-ahead is disabled for the U-proc, the function re-enables it (with a window of one page) after READAHEADMAX consecutive
+sequential faults. Note that the stack region is never read ahead and that the caller must hold mutual exclusion over the Swap Pool table. */
+void readAhead(support_t *supportStruct, int missingPgNo){
+	/* declaring local variables */
+	int asid; /* the ASID of the U-proc that took the page fault */
+	int pgNo; /* the logical page number that is being considered for read-ahead */
+	int queued; /* the number of pages that have been queued for read-ahead */
+
+	asid = supportStruct->sup_asid; /* initializing asid to the ASID of the U-proc that took the page fault */
+	if (missingPgNo != raNextPgNo[asid]){ /* if the page fault was not sequential */
+		raNextPgNo[asid] = missingPgNo + 1; /* a sequential page fault would be on the following page */
+		raSeqCnt[asid] = 0; /* resetting the number of consecutive sequential page faults */
+		return;
+	}
+
+	if (raWindow[asid] == 0){ /* if read-ahead is currently disabled for the U-proc */
+		raSeqCnt[asid]++; /* counting the sequential page fault */
+		raNextPgNo[asid] = missingPgNo + 1;
+		if (raSeqCnt[asid] < READAHEADMAX){ /* if the U-proc has not yet shown a long enough sequential run */
+			return;
+		}
+		raWindow[asid] = 1; /* re-enabling read-ahead for the U-proc with the smallest possible window */
+		raSeqCnt[asid] = 0;
 	}
 
+	queued = 0;
+	pgNo = missingPgNo + 1;
+	while ((queued < raWindow[asid]) && (pgNo < MMAPBASEPGNO)){ /* while the window is not full and we have not reached the mapped region window */
+		if (isZeroFillPage(supportStruct, pgNo) == TRUE){ /* if page pgNo has no contents on flash (i.e., we have reached the end of the load image) */
+			break;
+		}
+		if (((findPte(supportStruct, pgNo) == (pte_entry_t *) NULL) || (((findPte(supportStruct, pgNo)->entryLO) & VBITON) == ALLOFF)) && (findTransitFrame(asid, pgNo) == NOFRAME) && (zcacheFind(asid, pgNo) == NOZENTRY) && (findSharedFrame(supportStruct, pgNo) == NOFRAME)){ /* if page pgNo is neither valid, in transit, in the compressed page cache (whose copy is newer than the one on flash) nor shared by a U-proc running the same load image */
+			if (queueFrameRead(supportStruct, pgNo, TRUE) == NOFRAME){ /* if there are no free frames left in the Swap Pool */
+				break;
+			}
+			queued++;
+		}
+		pgNo++;
+	}
+	raNextPgNo[asid] = pgNo; /* a sequential page fault would be on the page following the last page read ahead */
+}
+
+/* Function that preloads the load image of the U-proc whose Support Structure is supportStruct into the Swap Pool before the U-proc
+executes its first instruction. The function queues block 0 of the U-proc's flash device (i.e., logical page 0, which begins with the
+aout header) for the read-ahead daemon and waits for it to be read. Using the size and location of the .data section recorded in the
+aout header, the function then queues the remaining .text and .data pages (as long as there are unoccupied frames left in the Swap
+Pool) and waits for all of them to be read, so that their Page Table entries are already valid when the U-proc is launched. Pages
+that do not fit in the Swap Pool are left to be brought in on demand. This function is invoked by test() when PRELOADUPROCS is TRUE. */
+void preloadUProc(support_t *supportStruct){
+	/* declaring local variables */
+	int asid; /* the ASID of the U-proc whose load image is being preloaded */
+	unsigned int *aoutHdr; /* a pointer to the aout header in the frame holding logical page 0 */
+	int imagePgCnt; /* the number of logical pages spanned by the .text and .data sections of the load image */
+	int lastPgNo; /* the logical page number of the last page that was queued to be read */
+	int pgNo; /* the logical page number that is being queued or waited on */
+
+	asid = supportStruct->sup_asid; /* initializing asid to the ASID of the U-proc whose load image is being preloaded */
 	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
 
-	/* determining the mising page number found in the saved exception state's EntryHI field */
-	missingPgNo = ((savedState->s_entryHI) & GETVPN) >> VPNSHIFT; /* initializing the missing page number to the VPN specified in the EntryHI field of the saved exception state */
-	missingPgNo = missingPgNo % ENTRIESPERPG; /* using the hash function to determine the page number of the missing TLB entry from the VPN calculated in the previous line */
+	if (queueFrameRead(supportStruct, 0, FALSE) == NOFRAME){ /* if there is no unoccupied frame to hold the aout header */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+		return; /* the whole load image will be brought in on demand */
+	}
+	waitForTransit(asid, 0); /* calling the internal helper function to wait for logical page 0 to be read */
 
-	frameNo = (frameNo + 1) % MAXFRAMECNT; /* selecting a frame to satisfy the page fault, as determined by Pandos' FIFO page replacement algorithm */
-	frameAddr = SWAPPOOLADDR + (frameNo * PAGESIZE); /* calculating the frameNo's starting address */
+	if (((findPte(supportStruct, 0)->entryLO) & VBITON) == ALLOFF){ /* if logical page 0 could not be read */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+		return; /* the whole load image will be brought in on demand */
+	}
 
-	if (swapPoolTbl[frameNo].asid != EMPTYFRAME){ /* if the frame selected by the page replacement algorithm is occupied */
-		setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and its cached counterpart in the TLB atomically */
-		swapPoolTbl[frameNo].ownerProc->entryLO = (swapPoolTbl[frameNo].ownerProc->entryLO) & VBITOFF; /* updating the page table for the process occupying the frame by marking the entry as not valid */
-		TLBCLR(); /* erasing all of the entries in the TLB to ensure cache consistency */
-		setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
-		flashOperation(WRITE, swapPoolTbl[frameNo].asid, frameAddr, swapPoolTbl[frameNo].pgNo); /* calling the internal helper function to update the correct process' backing store */
+	/* determining the number of logical pages spanned by the .text and .data sections from the aout header */
+	aoutHdr = (unsigned int *) ((findPte(supportStruct, 0)->entryLO) & GETPFN); /* the aout header is at the start of the frame holding logical page 0 */
+	identifyImage(supportStruct, recordImageBounds(supportStruct, aoutHdr)); /* calling the internal helper functions to record the bounds of the load image for the Pager and to identify it */
+	if (((findPte(supportStruct, 0)->entryLO) & VBITON) != ALLOFF){ /* if logical page 0 was not evicted while the load image was identified */
+		tagFrame((((findPte(supportStruct, 0)->entryLO) & GETPFN) - SWAPPOOLADDR) / PAGESIZE, supportStruct, 0); /* now that the load image is known, logical page 0 may be shared */
 	}
+	imagePgCnt = supportStruct->sup_imagePgCnt;
 
-	flashOperation(READ, curProcSupportStruct->sup_asid, frameAddr, missingPgNo); /* calling the internal helper function to read the contents of the Current Process' missing page number into frame frameNo */
+	/* queueing the remaining .text and .data pages to be read by the read-ahead daemon */
+	lastPgNo = 0;
+	while ((lastPgNo + 1 < imagePgCnt) && (queueFrameRead(supportStruct, lastPgNo + 1, FALSE) != NOFRAME)){ /* while there are pages left to queue and unoccupied frames to hold them */
+		lastPgNo++;
+	}
+
+	/* waiting for every queued page to be read, so that its Page Table entry is valid before the U-proc is launched */
+	for (pgNo = 1; pgNo <= lastPgNo; pgNo++){
+		waitForTransit(asid, pgNo); /* calling the internal helper function to wait for page pgNo to be read */
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+}
+
+/* Function that represents the read-ahead daemon, a support level process (executing in kernel-mode without a Support Structure)
+that is launched by test(). The daemon repeatedly waits for a frame to be placed on the read-ahead queue, reads the frame's page from
+its owner's flash device without holding mutual exclusion over the Swap Pool table, and then maps the page into its owner's Page Table
+and marks the frame as idle, waking any process that faulted on the page while it was in transit. Note that the page is mapped clean
+(i.e., with its D bit off) and that its software reference bit is left off, so that the Pager can later determine whether the page was ever used. If the read fails, the frame is
+simply returned to the Swap Pool as unoccupied, and the page will be read on demand instead. */
+void readAheadDaemon(){
+	/* declaring local variables */
+	int frameNo; /* the frame number that the daemon is reading a page into */
+	memaddr frameAddr; /* the address of the frame that the daemon is reading a page into */
+	int statusCode; /* the status code returned by the flash read */
 
-	/* updating the Swap Pool table to reflect the frame's new contents */
-	swapPoolTbl[frameNo].pgNo = missingPgNo; /* updating the page number field for the appropriate frame's entry in the Swap Pool table */
-	swapPoolTbl[frameNo].asid = curProcSupportStruct->sup_asid; /* updating the ASID field for the appropriate frame's entry in the Swap Pool table */
-	swapPoolTbl[frameNo].ownerProc = &(curProcSupportStruct->sup_privatePgTbl[missingPgNo]); /* updating the ownerProc field in the appropriate frame's entry in the Swap Pool table */
+	while (TRUE){
+		mutex(TRUE, (int *) &raQueueSem); /* performing a P operation on the read-ahead queue's semaphore to wait for a frame to read */
+		mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+		frameNo = raQueue[raHead]; /* removing the frame at the head of the read-ahead queue */
+		raHead = (raHead + 1) % MAXFRAMECNT;
+		raCount--;
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table while the frame is read */
 
-	setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+		frameAddr = SWAPPOOLADDR + (frameNo * PAGESIZE); /* calculating the frameNo's starting address */
+		statusCode = readPage(swapPoolTbl[frameNo].asid, swapPoolTbl[frameNo].pgNo, frameAddr); /* calling the internal helper function to read the page into the frame */
+
+		mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to regain mutual exclusion over the Swap Pool table */
+		if (statusCode == READY){ /* if the page was read successfully */
+			setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+			swapPoolTbl[frameNo].ownerProc->entryLO = frameAddr | VBITON | ((swapPoolTbl[frameNo].ownerProc->entryLO) & PTEBACKEDBITON); /* mapping the page with its D bit and software reference bit off */
+			swapPoolTbl[frameNo].dirty = FALSE; /* the frame's contents match its owner's flash device */
+			tlbInvalidate(swapPoolTbl[frameNo].ownerProc); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+			setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+		}
+		else{ /* the read led to an error status */
+			swapPoolTbl[frameNo].asid = EMPTYFRAME; /* returning the frame to the Swap Pool as unoccupied */
+			swapPoolTbl[frameNo].prefetched = FALSE;
+		}
+		releaseFrame(frameNo); /* calling the internal helper function to mark the frame as idle and wake any processes waiting on it */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+	}
+}
+
+/* Function that counts the frames in the Swap Pool that can be replaced without first being written to flash (i.e., idle frames that
+are either unoccupied or clean) and, if there are fewer than CLEANWATERMARK of them, wakes the page cleaner daemon (unless it has
+already been woken). The page cleaner is also woken if fewer than ZCLEANCHUNKS chunks of the compressed page cache are free. Note
+that the caller must hold mutual exclusion over the Swap Pool table. */
+void checkWatermark(){
+	int i;
+	int cleanCnt; /* the number of frames that can be replaced without a flash write */
+
+	cleanCnt = 0;
+	for (i = 0; i < MAXFRAMECNT; i++){
+		if ((swapPoolTbl[i].frameState == FRAMEIDLE) && ((swapPoolTbl[i].asid == EMPTYFRAME) || (swapPoolTbl[i].dirty == FALSE))){ /* if frame i can be replaced without a flash write */
+			cleanCnt++;
+		}
+	}
+	if (((cleanCnt < CLEANWATERMARK) || (zFreeChunks < ZCLEANCHUNKS)) && (cleanerPending == FALSE)){ /* if too few frames are clean (or the compressed page cache is nearly full) and the page cleaner is not already awake */
+		cleanerPending = TRUE;
+		mutex(FALSE, (int *) &cleanerSem); /* performing a V operation on the page cleaner's semaphore to wake it */
+	}
+}
+
+/* Function that writes the frames burst[0] through burst[cnt - 1] to the cnt adjacent swap slots starting at slot firstSlot (which lie
+in a single cluster, and hence on a single swap device), recording the status code of each write in burstStatus. The writes are performed
+one at a time with flashTransfer(), each one submitted once the previous one has completed, so requests that other processes submit to
+the swap device in the meantime may be served between them. They cannot all be submitted at once, since the device's semaphore wakes
+blocked processes in the order they blocked, and only a process with a single outstanding request is sure to be woken by its own. */
+void writeCluster(int firstSlot, int *burst, int *burstStatus, int cnt){
+	int k; /* loop variable */
+
+	for (k = 0; k < cnt; k++){
+		burstStatus[k] = flashTransfer(WRITE, SLOTTODEV(firstSlot), SWAPPOOLADDR + (burst[k] * PAGESIZE), SLOTTOBLOCK(firstSlot + k)); /* writing the k-th frame of the burst to the k-th slot of the run */
+	}
+}
+
+/* Function that represents the page cleaner daemon, a support level process launched by test(). Each time it is woken (by the
+Pseudo-clock daemon or by the Pager when too few frames are clean), the daemon examines the CLEANAHEAD frames that the FIFO page
+replacement algorithm will select next, and writes the ones that are occupied, idle and dirty (other than pages of mapped regions) to swap in bursts of up to SWAPCLUSTER
+frames. The pages of a burst are moved to a run of adjacent swap slots (freeing the slots they were previously written to), so that the
+burst is written to consecutive blocks of one swap device; if no run is free, each page keeps (or is given) a slot of its own. Before
+a frame is written, it is marked as in transit (so that it is not selected as a victim mid-write), it is marked as clean and the D bit
+of its owner's Page Table entry is turned off, so that a store performed by the owner while the write is in progress raises a
+TLB-Modification exception and marks the frame as dirty once again. The page remains mapped for reading throughout. Finally, the
+daemon writes the oldest pages in the compressed page cache back to swap until enough of the cache is free. */
+void pageCleanerDaemon(){
+	/* declaring local variables */
+	int i; /* the number of frames ahead of the FIFO page replacement algorithm's position that the daemon is examining */
+	int k; /* the position in the burst of the frame that the daemon is handling */
+	int frameNo; /* the frame number that the daemon is examining */
+	int burst[SWAPCLUSTER]; /* the frames that the daemon writes in the current burst */
+	int burstStatus[SWAPCLUSTER]; /* the status code returned by the write of each frame in the current burst */
+	int burstCnt; /* the number of frames in the current burst */
+	int firstSlot; /* the first of the run of adjacent swap slots that the burst is written to (or NOSLOT if the pages are written one at a time) */
+	rmap_t *r; /* a pointer to the reverse map entry of a U-proc sharing the frame that the daemon is writing */
+
+	while (TRUE){
+		mutex(TRUE, (int *) &cleanerSem); /* performing a P operation on the page cleaner's semaphore to wait to be woken */
+		mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+		cleanerPending = FALSE; /* the page cleaner is starting its pass */
+
+		i = 1;
+		while (i <= CLEANAHEAD){
+			/* gathering the next burst of frames that are idle, occupied and dirty */
+			burstCnt = 0;
+			while ((i <= CLEANAHEAD) && (burstCnt < SWAPCLUSTER)){
+				frameNo = (nextFrameNo + i) % MAXFRAMECNT; /* the frame that the FIFO page replacement algorithm will select i selections from now */
+				if ((swapPoolTbl[frameNo].frameState == FRAMEIDLE) && (swapPoolTbl[frameNo].asid != EMPTYFRAME) && (swapPoolTbl[frameNo].dirty == TRUE)
+					&& (mmapFind(swapPoolTbl[frameNo].asid, swapPoolTbl[frameNo].pgNo) == NOREGION)){ /* if the frame is idle, occupied and dirty (and its page is not part of a mapped region, which is written back on eviction or SYS26) */
+					burst[burstCnt] = frameNo;
+					burstCnt++;
+				}
+				i++;
+			}
+			if (burstCnt == 0){ /* if there is nothing left to write */
+				continue;
+			}
+
+			/* moving the burst's pages to a run of adjacent swap slots, if one is free */
+			firstSlot = allocSlotRun(burstCnt); /* calling the internal helper function to allocate a run of adjacent swap slots */
+			for (k = 0; k < burstCnt; k++){
+				frameNo = burst[k];
+				if (firstSlot != NOSLOT){ /* if the burst is written to a run of adjacent slots */
+					freeSlots(swapPoolTbl[frameNo].asid, swapPoolTbl[frameNo].pgNo, 1); /* calling the internal helper function to free the slot the page was previously written to */
+					pgSlot[swapPoolTbl[frameNo].asid][swapPoolTbl[frameNo].pgNo] = firstSlot + k;
+				}
+				else{
+					assignSlot(swapPoolTbl[frameNo].asid, swapPoolTbl[frameNo].pgNo); /* calling the internal helper function to give the page a slot of its own */
+				}
+
+				/* write-protecting the page and marking the frame as in transit before the write is performed */
+				swapPoolTbl[frameNo].frameState = FRAMEBUSY; /* marking the frame as in transit, so that no page fault selects it */
+				swapPoolTbl[frameNo].evictAsid = EMPTYFRAME; /* no page is being written out of the frame, since the page remains mapped */
+				swapPoolTbl[frameNo].dirty = FALSE; /* the frame will be clean once the write completes, unless it is modified in the meantime */
+				setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+				swapPoolTbl[frameNo].ownerProc->entryLO = ((swapPoolTbl[frameNo].ownerProc->entryLO) & DBITOFF) | PTEBACKEDBITON; /* turning the D bit off (and recording that the page is written to swap) */
+				for (r = swapPoolTbl[frameNo].sharers; r != (rmap_t *) NULL; r = r->r_next){
+					r->r_pte->entryLO = (r->r_pte->entryLO) & DBITOFF; /* turning the D bit off in every U-proc sharing the frame, so that their next store marks the frame as dirty again */
+					tlbInvalidate(r->r_pte); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+				}
+				tlbInvalidate(swapPoolTbl[frameNo].ownerProc); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+				setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+			}
+			mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table while the burst is written */
+
+			if (firstSlot != NOSLOT){ /* if the burst is written to a run of adjacent slots */
+				writeCluster(firstSlot, burst, burstStatus, burstCnt); /* calling the internal helper function to write the burst to consecutive blocks of the swap device */
+			}
+			else{
+				for (k = 0; k < burstCnt; k++){
+					burstStatus[k] = writePage(swapPoolTbl[burst[k]].asid, swapPoolTbl[burst[k]].pgNo, SWAPPOOLADDR + (burst[k] * PAGESIZE)); /* calling the internal helper function to write the frame to its page's swap slot */
+				}
+			}
+
+			mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to regain mutual exclusion over the Swap Pool table */
+			for (k = 0; k < burstCnt; k++){
+				if (burstStatus[k] != READY){ /* if the write led to an error status (or the swap area is full) */
+					swapPoolTbl[burst[k]].dirty = TRUE; /* the frame is still dirty, so the Pager will write it when it is evicted */
+				}
+				releaseFrame(burst[k]); /* calling the internal helper function to mark the frame as idle and wake any processes waiting on it */
+			}
+		}
+		zcacheWriteBack(); /* calling the internal helper function to write the oldest cached pages back to swap, if the compressed page cache is nearly full */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+	}
+}
+
+/* Function that represents the Pseudo-clock daemon, a support level process launched by test(). The daemon waits for each Pseudo-clock
+tick (i.e., every 100 milliseconds), runs the Pager's load control over the page faults taken during the tick, and wakes the page
+cleaner daemon, unless it has already been woken, so that dirty frames are written back in the background even when the Pager has
+not signalled that too few frames are clean. */
+void pseudoClockDaemon(){
+	while (TRUE){
+		SYSCALL(SYS7NUM, 0, 0, 0); /* waiting for the next Pseudo-clock tick */
+		mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+		loadControl(); /* calling the internal helper function to suspend or resume U-procs based on the page faults taken during the tick */
+		if (cleanerPending == FALSE){ /* if the page cleaner is not already awake */
+			cleanerPending = TRUE;
+			mutex(FALSE, (int *) &cleanerSem); /* performing a V operation on the page cleaner's semaphore to wake it */
+		}
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+	}
+}
+
+/* Function that implements the Pager's load control, which is run by the Pseudo-clock daemon once per Pseudo-clock tick. If the U-procs
+took more than THRASHFAULTS page faults during the tick and more than one U-proc is still competing for frames, the function chooses
+the competing U-proc that took the most page faults for suspension (unless a U-proc has already been chosen and has not yet been
+suspended). Otherwise, if the U-procs took fewer than RESUMEFAULTS page faults, the function resumes the U-proc that has been suspended
+the longest. Either way, the page fault counts are then reset for the next tick. Note that the caller must hold mutual exclusion over
+the Swap Pool table. */
+void loadControl(){
+	/* declaring local variables */
+	int asid; /* the ASID of the U-proc being examined */
+	int totalFaults; /* the number of page faults taken by all U-procs during the tick */
+	int activeCnt; /* the number of U-procs that are still competing for frames */
+	int pendingCnt; /* the number of U-procs that have been chosen for suspension but have not yet been suspended */
+	int victim; /* the ASID of the U-proc chosen for suspension */
+
+	totalFaults = 0;
+	activeCnt = 0;
+	pendingCnt = 0;
+	victim = NOUPROC;
+	for (asid = 1; asid <= UPROCMAX; asid++){
+		totalFaults += lcFaultCnt[asid];
+		if (lcState[asid] == LCPENDING){ /* if the U-proc has already been chosen for suspension */
+			pendingCnt++;
+		}
+		if (lcState[asid] == LCACTIVE){ /* if the U-proc is competing for frames */
+			activeCnt++;
+			if ((pinPgCnt[asid] == 0) && ((victim == NOUPROC) || (lcFaultCnt[asid] > lcFaultCnt[victim]))){ /* if the U-proc took the most page faults so far (U-procs that have pinned pages are never suspended) */
+				victim = asid;
+			}
+		}
+	}
+
+	if ((totalFaults > THRASHFAULTS) && (activeCnt > 1) && (pendingCnt == 0) && (victim != NOUPROC)){ /* if the system is thrashing and suspending a U-proc still leaves one running */
+		lcState[victim] = LCPENDING; /* the U-proc is suspended when it next takes a page fault */
+	}
+	else if (totalFaults < RESUMEFAULTS){ /* if the page fault rate has dropped enough to let a suspended U-proc back in */
+		resumeUProc(); /* calling the internal helper function to resume the U-proc that has been suspended the longest */
+	}
+
+	for (asid = 1; asid <= UPROCMAX; asid++){
+		lcFaultCnt[asid] = 0; /* resetting the page fault counts for the next tick */
+	}
+	lcTick++;
+}
+
+/* Function that resumes the U-proc that has been suspended the longest (if any), by marking it as competing for frames once again and
+performing a V operation on its resume semaphore. Note that the caller must hold mutual exclusion over the Swap Pool table. */
+void resumeUProc(){
+	int asid;
+	int oldest; /* the ASID of the U-proc that has been suspended the longest */
+
+	oldest = NOUPROC;
+	for (asid = 1; asid <= UPROCMAX; asid++){
+		if ((lcState[asid] == LCSUSPENDED) && ((oldest == NOUPROC) || (lcSuspendTick[asid] < lcSuspendTick[oldest]))){
+			oldest = asid;
+		}
+	}
+	if (oldest != NOUPROC){ /* if there is a suspended U-proc */
+		lcState[oldest] = LCACTIVE;
+		mutex(FALSE, (int *) &(lcResumeSem[oldest])); /* performing a V operation on the U-proc's resume semaphore to resume it */
+	}
+}
+
+/* Function that suspends the U-proc whose Support Structure is supportStruct, which has been chosen for suspension by the load control
+and has just taken a page fault. The U-proc's mappings of frames it shares are removed, frames holding its .text pages that other U-procs
+share are handed over to one of them, every other idle frame occupied by one of the U-proc's pages is returned to the Swap Pool as unoccupied, and
+the corresponding Page Table entries are marked as not valid; dirty frames are first placed in the compressed page cache or, if they do
+not fit, written to swap (while
+marked as in transit, and without holding mutual exclusion over the Swap Pool table during the write). The U-proc then waits on its
+resume semaphore until the load control resumes it. Note that the caller must hold mutual exclusion over the Swap Pool table, which
+is released while the U-proc is suspended and is held again when the function returns. */
+void suspendUProc(support_t *supportStruct){
+	/* declaring local variables */
+	int asid; /* the ASID of the U-proc being suspended */
+	int frameNo; /* the frame number being released */
+	int pgNo; /* the logical page number of the page occupying the frame being released */
+	int statusCode; /* the status code returned by the flash write */
+
+	asid = supportStruct->sup_asid; /* initializing asid to the ASID of the U-proc being suspended */
+	for (frameNo = 0; frameNo < MAXFRAMECNT; frameNo++){
+		dropSharer(frameNo, asid); /* calling the internal helper function to remove the U-proc's mapping of the frame, if it shares the frame */
+		if ((swapPoolTbl[frameNo].asid == asid) && (swapPoolTbl[frameNo].segNo == NOSEG) && (swapPoolTbl[frameNo].frameState == FRAMEIDLE) && (swapPoolTbl[frameNo].sharers != (rmap_t *) NULL)){ /* if the frame is one of the U-proc's .text pages that other U-procs share */
+			setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+			swapPoolTbl[frameNo].ownerProc->entryLO = (swapPoolTbl[frameNo].ownerProc->entryLO) & VBITOFF; /* marking the page as not valid */
+			tlbInvalidate(swapPoolTbl[frameNo].ownerProc); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+			setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+			promoteSharer(frameNo); /* calling the internal helper function to hand the frame over to one of its sharers */
+		}
+		else if ((swapPoolTbl[frameNo].asid == asid) && (swapPoolTbl[frameNo].segNo == NOSEG) && (swapPoolTbl[frameNo].frameState == FRAMEIDLE)){ /* if the frame is idle and occupied by one of the U-proc's pages (rather than a segment page backed by its flash device) */
+			pgNo = swapPoolTbl[frameNo].pgNo;
+			setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+			swapPoolTbl[frameNo].ownerProc->entryLO = (swapPoolTbl[frameNo].ownerProc->entryLO) & VBITOFF; /* marking the page as not valid */
+			if (swapPoolTbl[frameNo].dirty == TRUE){ /* if the page is about to be written out */
+				swapPoolTbl[frameNo].ownerProc->entryLO = (swapPoolTbl[frameNo].ownerProc->entryLO) | PTEBACKEDBITON; /* recording that the page is written to swap */
+			}
+			tlbInvalidate(swapPoolTbl[frameNo].ownerProc); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+			setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+			swapPoolTbl[frameNo].asid = EMPTYFRAME; /* returning the frame to the Swap Pool as unoccupied */
+			swapPoolTbl[frameNo].prefetched = FALSE;
+			if ((swapPoolTbl[frameNo].dirty == TRUE) && (zcacheStore(asid, pgNo, SWAPPOOLADDR + (frameNo * PAGESIZE)) == TRUE)){ /* if the page was placed in the compressed page cache */
+				swapPoolTbl[frameNo].dirty = FALSE; /* the page no longer needs to be written to flash */
+			}
+
+			if (swapPoolTbl[frameNo].dirty == TRUE){ /* if the page must be written back before the frame can be reused */
+				swapPoolTbl[frameNo].frameState = FRAMEBUSY; /* marking the frame as in transit, so that no page fault selects it */
+				swapPoolTbl[frameNo].evictAsid = asid; /* recording the ASID of the page being written out of the frame */
+				swapPoolTbl[frameNo].evictPgNo = pgNo; /* recording the logical page number of the page being written out of the frame */
+				swapPoolTbl[frameNo].dirty = FALSE;
+				assignSlot(asid, pgNo); /* calling the internal helper function to make sure that the page has a swap slot */
+				mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table while the frame is written */
+				statusCode = writePage(asid, pgNo, SWAPPOOLADDR + (frameNo * PAGESIZE)); /* calling the internal helper function to write the page to its swap slot */
+				mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to regain mutual exclusion over the Swap Pool table */
+				releaseFrame(frameNo); /* calling the internal helper function to mark the frame as idle and wake any processes waiting on it */
+				if (statusCode != READY){ /* if the write led to an error status, the page's contents are lost */
+					mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to make sure we release mutual exclusion over the Swap Pool table */
+					programTrapHandler(); /* invoking the function that handles program traps in phase 3 */
+				}
+			}
+		}
+	}
+
+	lcState[asid] = LCSUSPENDED; /* the U-proc no longer holds any idle frames */
+	lcSuspendTick[asid] = lcTick; /* recording when the U-proc was suspended, so that suspended U-procs are resumed in FIFO order */
+	raNextPgNo[asid] = NOPAGE; /* the U-proc's next page fault is not part of a sequential run */
+	checkWatermark(); /* calling the internal helper function to wake the page cleaner, if too few frames are clean */
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table while the U-proc is suspended */
+	mutex(TRUE, (int *) &(lcResumeSem[asid])); /* performing a P operation on the U-proc's resume semaphore to wait to be resumed */
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to regain mutual exclusion over the Swap Pool table */
+}
 
-	/* updating the appropriate Page Table entry for the Current Process */
-	curProcSupportStruct->sup_privatePgTbl[missingPgNo].entryLO = frameAddr | VBITON | DBITON; /* ensuring the V and D bits are on and that the PFN field of the appropriate Page Table entry for the Current Process is updated */
+/* Function that is called when the U-proc whose ASID is asid terminates. Once the transfers of any of the U-proc's pages that are in
+progress have completed, the U-proc's pins are released, the U-proc's mappings of frames it shares are removed, frames holding its .text pages that other U-procs share
+are handed over to one of them, and every other frame occupied by one of the U-proc's pages is returned to the Swap Pool as unoccupied (without being written back, since the U-proc will never need its pages again), the U-proc's
+pages are removed from the compressed page cache, the swap slots of its pages are reclaimed, the tables of Page Table entries allocated to the U-proc are returned to the pool,
+the U-proc
+no longer takes part in the Pager's load control, and, since frames have been freed, the U-proc that has been suspended the longest
+(if any) is resumed. */
+void releaseUProcFrames(int asid){
+	int frameNo;
+	int i;
 
-	TLBCLR(); /* erasing all of the entries in the TLB to ensure cache consistency */
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	waitForWriteBack(asid, 0, MAXUPAGES); /* calling the internal helper function to wait until none of the U-proc's pages is being read or written */
+	unpinRange(asid, 0, MAXUPAGES); /* calling the internal helper function to release the U-proc's pins */
+	pinTotal -= pinPgCnt[asid]; /* returning any pages reserved by a SYS23 request that did not complete to the system-wide limit */
+	pinPgCnt[asid] = 0;
+	for (frameNo = 0; frameNo < MAXFRAMECNT; frameNo++){
+		dropSharer(frameNo, asid); /* calling the internal helper function to remove the U-proc's mapping of the frame, if it shares the frame */
+		if ((swapPoolTbl[frameNo].asid == asid) && (swapPoolTbl[frameNo].segNo == NOSEG) && (swapPoolTbl[frameNo].frameState == FRAMEIDLE) && (swapPoolTbl[frameNo].sharers != (rmap_t *) NULL)){ /* if the frame holds one of the U-proc's .text pages that other U-procs share */
+			promoteSharer(frameNo); /* calling the internal helper function to hand the frame over to one of its sharers */
+		}
+		else if ((swapPoolTbl[frameNo].asid == asid) && (swapPoolTbl[frameNo].segNo == NOSEG) && (swapPoolTbl[frameNo].frameState == FRAMEIDLE)){ /* if the frame is idle and occupied by one of the U-proc's pages (rather than a segment page backed by its flash device) */
+			swapPoolTbl[frameNo].asid = EMPTYFRAME; /* returning the frame to the Swap Pool as unoccupied */
+			swapPoolTbl[frameNo].prefetched = FALSE;
+			swapPoolTbl[frameNo].dirty = FALSE;
+		}
+	}
+	for (i = 0; i < ZENTRYCNT; i++){
+		if ((zcacheTbl[i].state == ZCACHED) && (zcacheTbl[i].asid == asid) && (zcacheTbl[i].pgNo < SHMBLOCKBASE)){ /* if the entry holds one of the U-proc's pages (rather than a segment page backed by its flash device) */
+			zcacheDrop(i); /* calling the internal helper function to remove the page from the compressed page cache */
+		}
+	}
+	freeSlots(asid, 0, MAXUPAGES); /* calling the internal helper function to reclaim the swap slots of the U-proc's pages */
+	for (i = 0; i < PGTBLPOOLSIZE; i++){
+		if (pgTblOwner[i] == asid){ /* if the table was allocated to the U-proc */
+			pgTblOwner[i] = EMPTYFRAME; /* returning the table to the pool */
+		}
+	}
+	setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can empty the TLBs atomically */
+	tlbFlush(); /* calling the nucleus function that erases every cached Page Table entry, so that none survives for the U-proc's ASID */
 	setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+	lcState[asid] = LCEXITED; /* the U-proc no longer competes for frames */
+	resumeUProc(); /* calling the internal helper function to resume the U-proc that has been suspended the longest, since frames have been freed */
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+}
+
+/* Function that initializes the table of Page Table entries pgTbl, which is (or is about to be) pointed to by entry dirNo of the page
+directory of the U-proc whose ASID is asid. Each entry's EntryHI field holds the VPN of the logical page it maps and the U-proc's ASID,
+and each entry's EntryLO field has its G and V bits off and its D bit on. */
+void initPteTbl(pte_entry_t *pgTbl, int dirNo, int asid){
+	int j;
+	for (j = 0; j < ENTRIESPERPG; j++){
+		pgTbl[j].entryHI = ALLOFF | (PGNOTOVPN((dirNo * ENTRIESPERPG) + j) << VPNSHIFT) | (asid << ASIDSHIFT); /* initializing the EntryHI field of the entry */
+		pgTbl[j].entryLO = ALLOFF | DBITON; /* initializing the EntryLo field of the entry so that the G and V bits are off and the D bit is on */
+	}
+}
+
+/* Function that initializes the two-level Page Table of the U-proc whose Support Structure is supportStruct. The first entry of the
+page directory points to the table of Page Table entries in the Support Structure, while the remaining entries are NULL until the Pager
+allocates their tables on demand. This function is invoked by test() before each U-proc is launched. */
+void initPageTable(support_t *supportStruct){
+	int i;
+	for (i = 0; i < PGDIRSIZE; i++){
+		supportStruct->sup_pgDir[i] = (pte_entry_t *) NULL; /* no table is allocated for the directory entry yet */
+	}
+	supportStruct->sup_pgDir[0] = supportStruct->sup_privatePgTbl; /* the first directory entry points to the table in the Support Structure */
+	initPteTbl(supportStruct->sup_privatePgTbl, 0, supportStruct->sup_asid); /* calling the internal helper function to initialize the first table */
+	for (i = 0; i < SHMSEGMAX; i++){
+		supportStruct->sup_shmMode[i] = SHMDETACHED; /* the U-proc starts out with no shared memory segment attached */
+	}
+}
+
+/* Function that allocates a table of Page Table entries from the pool for entry dirNo of the page directory of the U-proc whose Support
+Structure is supportStruct, initializes it and installs it in the page directory. The function returns TRUE if a table was allocated,
+and FALSE if the pool is exhausted. Note that the caller must hold mutual exclusion over the Swap Pool table. */
+int allocPgTbl(support_t *supportStruct, int dirNo){
+	int i;
+
+	i = 0;
+	while ((i < PGTBLPOOLSIZE) && (pgTblOwner[i] != EMPTYFRAME)){
+		i++;
+	}
+	if (i == PGTBLPOOLSIZE){ /* if every table in the pool is allocated */
+		return FALSE;
+	}
+	pgTblOwner[i] = supportStruct->sup_asid; /* allocating table i to the U-proc */
+	initPteTbl(pgTblPool[i], dirNo, supportStruct->sup_asid); /* calling the internal helper function to initialize the table */
+	supportStruct->sup_pgDir[dirNo] = pgTblPool[i]; /* installing the table in the U-proc's page directory */
+	return TRUE;
+}
+
+/* Function that returns a pointer to the Page Table entry for logical page pgNo of the U-proc whose Support Structure is supportStruct, or
+NULL if the table that would hold the entry has not been allocated yet. */
+pte_entry_t *findPte(support_t *supportStruct, int pgNo){
+	pte_entry_t *pgTbl;
+
+	pgTbl = supportStruct->sup_pgDir[pgNo / ENTRIESPERPG]; /* looking up the table that holds the entry in the page directory */
+	if (pgTbl == (pte_entry_t *) NULL){ /* if the table has not been allocated yet */
+		return (pte_entry_t *) NULL;
+	}
+	return &(pgTbl[pgNo % ENTRIESPERPG]);
+}
+
+/* Function that determines whether a page fault on logical page pgNo of the U-proc whose Support Structure is supportStruct is a legal
+access, as far as the U-proc's stack is concerned. Pages outside of the stack region are always legal (here), as are the stack pages
+that the stack has already grown to. A page fault on one of the STACKGAPPGS pages just below the current bottom of the stack grows the
+stack down to that page, as long as the U-proc's stack limit is not exceeded; the new stack pages are zero-filled by the Pager when
+they are first touched. The function returns TRUE if the access is legal, and FALSE if it lies beyond the bottom of the stack (i.e.,
+it is a stack overflow or a stray pointer). Note that only the U-proc itself ever changes its stack bookkeeping. */
+int checkStackAccess(support_t *supportStruct, int pgNo){
+	int stackPgNo; /* the number of pages between the stack page and the faulting page */
+
+	if (pgNo < LOWPGMAX){ /* if the page is not in the stack region */
+		return TRUE;
+	}
+	stackPgNo = MAXUPAGES - 1 - pgNo; /* the stack page is stack page 0, and the stack grows towards higher stack page numbers */
+	if (stackPgNo < supportStruct->sup_stackPgCnt){ /* if the stack has already grown to the page */
+		return TRUE;
+	}
+	if ((stackPgNo < supportStruct->sup_stackPgCnt + STACKGAPPGS) && (stackPgNo < supportStruct->sup_stackLimit)){ /* if the page lies just below the bottom of the stack and within the U-proc's stack limit */
+		supportStruct->sup_stackPgCnt = stackPgNo + 1; /* growing the stack down to the page */
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/* Function that pins the page of the U-proc whose Support Structure is supportStruct that holds the virtual address vAddr into the
+Swap Pool and returns the number of the frame holding it. The function touches the address, so that the page is brought in by the
+Pager if it is not resident, and then, while holding mutual exclusion over the Swap Pool table, increments the pin count of the frame
+that the page is mapped to; if the page was evicted again in the meantime, the function simply tries again. A pinned frame is never
+selected for replacement, so the page stays resident (and its mapping valid) until the caller releases the pin with unpinFrame(). Note
+that the caller must not hold mutual exclusion over the Swap Pool table, and that the function raises a Program Trap (through the
+Pager) if vAddr is not a legal address for the U-proc. */
+int pinUserPage(support_t *supportStruct, memaddr vAddr){
+	/* declaring local variables */
+	volatile char *touch; /* a pointer through which the function reads the byte at vAddr */
+	pte_entry_t *pte; /* a pointer to the U-proc's Page Table entry for the page */
+	int frameNo; /* the frame holding the page (NOFRAME until the page has been pinned) */
+
+	touch = (volatile char *) vAddr;
+	frameNo = NOFRAME;
+	while (frameNo == NOFRAME){
+		(void) *touch; /* reading the byte at vAddr, which raises a page fault if the page is not resident */
+		mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+		pte = findPte(supportStruct, VPNTOPGNO((vAddr & GETVPN) >> VPNSHIFT)); /* locating the U-proc's Page Table entry for the page */
+		if ((pte != (pte_entry_t *) NULL) && (((pte->entryLO) & VBITON) != ALLOFF)){ /* if the page is still resident */
+			frameNo = (((pte->entryLO) & GETPFN) - SWAPPOOLADDR) / PAGESIZE; /* determining the frame holding the page from the entry's PFN */
+			swapPoolTbl[frameNo].pinCnt++;
+		}
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+	}
+	return frameNo;
+}
+
+/* Function that releases a pin on frame frameNo that was taken by pinUserPage(). Note that the caller must not hold mutual exclusion
+over the Swap Pool table. */
+void unpinFrame(int frameNo){
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	swapPoolTbl[frameNo].pinCnt--;
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+}
+
+/* Function that pins the page of the U-proc whose Support Structure is supportStruct that holds the virtual address vAddr, so that a
+disk or flash device can transfer a block directly to or from the frame holding it. If the device will store into the frame (i.e., if
+readOrWrite is READ), the page is first made writable with makeWritable(), so that a copy-on-write segment page is copied before the
+frame is handed to the device, and the frame is marked dirty. Should the page have been evicted and read in again without its D bit
+between the two steps, the pin is released and the function tries again. The function returns the number of the pinned frame, or
+NOFRAME if the device may not store into the page (e.g., a .text page), in which case the caller falls back to copying the block. Note
+that the caller must not hold mutual exclusion over the Swap Pool table. */
+int pinDmaPage(support_t *supportStruct, memaddr vAddr, int readOrWrite){
+	/* declaring local variables */
+	int frameNo; /* the frame holding the page (NOFRAME until a frame has been pinned that the device may use) */
+	int writable; /* TRUE if the pinned page is still mapped with its D bit on */
+
+	frameNo = NOFRAME;
+	while (frameNo == NOFRAME){
+		if ((readOrWrite == READ) && (makeWritable(supportStruct, vAddr) == FALSE)){ /* if the device may not store into the page */
+			return NOFRAME;
+		}
+		frameNo = pinUserPage(supportStruct, vAddr); /* calling the internal helper function to pin the page */
+		if (readOrWrite == READ){
+			mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+			writable = pageWritable(supportStruct, vAddr);
+			if (writable == TRUE){
+				swapPoolTbl[frameNo].dirty = TRUE; /* marking the frame as dirty, since the device is about to modify its page */
+			}
+			else{ /* the page lost its D bit after makeWritable() returned, so the pin is released and the function tries again */
+				swapPoolTbl[frameNo].pinCnt--;
+				frameNo = NOFRAME;
+			}
+			mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+		}
+	}
+	return frameNo;
+}
+
+/* Function that releases the pin on frame frameNo that was taken by pinDmaPage() once the device has completed its transfer. If the
+device stored into the frame (i.e., if readOrWrite is READ), the frame is marked dirty once again, since the page cleaner may have
+written the frame to swap (and marked it clean) while the transfer was in progress. Note that the caller must not hold mutual exclusion
+over the Swap Pool table. */
+void unpinDmaFrame(int frameNo, int readOrWrite){
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	if (readOrWrite == READ){
+		swapPoolTbl[frameNo].dirty = TRUE;
+	}
+	swapPoolTbl[frameNo].pinCnt--;
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+}
+
+/* Function that determines whether the len bytes starting at the virtual address vAddr all lie within the address space of the U-proc
+whose Support Structure is supportStruct (i.e., in KUSEG, without wrapping around, and on pages that are legal for the U-proc). If
+forStore is TRUE, none of the bytes may lie on one of the U-proc's read-only .text pages either, since the support level is about to
+store into them. The function returns TRUE if the range is valid and FALSE otherwise, so that a support level service can reject a
+request before any of it has been performed. */
+int validRange(support_t *supportStruct, memaddr vAddr, int len, int forStore){
+	/* declaring local variables */
+	unsigned int vpn; /* the VPN of the page being examined */
+	int pgNo; /* the logical page number of the page being examined */
+
+	if ((vAddr < KUSEG) || (len < 0) || (vAddr + len < vAddr)){ /* if the range starts outside of KUSEG or wraps around */
+		return FALSE;
+	}
+	if (len == 0){
+		return TRUE;
+	}
+	for (vpn = (vAddr & GETVPN) >> VPNSHIFT; vpn <= ((vAddr + len - 1) & GETVPN) >> VPNSHIFT; vpn++){
+		pgNo = VPNTOPGNO(vpn);
+		if ((pgNo == NOPAGE) || ((forStore == TRUE) && (pgNo < supportStruct->sup_textPgCnt))){ /* if the page lies outside of the U-proc's address space or may not be stored into */
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/* Internal helper function that copies the len bytes starting at kernel address src to the kernel address dest. When both addresses are
+word-aligned, the bytes are copied a word at a time, and only the bytes left over are copied one at a time. */
+void copyChunk(char *dest, char *src, int len){
+	int i; /* loop variable */
+
+	i = 0;
+	if (((((memaddr) dest) % WORDLEN) == 0) && ((((memaddr) src) % WORDLEN) == 0)){ /* if the addresses are word-aligned */
+		for (i = 0; i + WORDLEN <= len; i += WORDLEN){
+			*((int *) (dest + i)) = *((int *) (src + i));
+		}
+	}
+	for (; i < len; i++){
+		dest[i] = src[i];
+	}
+}
+
+/* Function that copies the len bytes starting at the virtual address src in the address space of the U-proc whose Support Structure is
+supportStruct into the kernel buffer dest, on behalf of a support level service. The function validates the whole range with
+validRange() first, and then handles one page at a time: the page is brought in (if necessary) and pinned with pinUserPage(), its bytes
+are copied out of the frame holding it, and the pin is released. Since the bytes are read through the frame's kernel address, the copy
+itself never raises a TLB exception, and the page cannot be evicted half-way through it. The function returns TRUE if the bytes were
+copied and FALSE if the range is not valid (in which case nothing is copied). Note that the caller must not hold mutual exclusion over
+the Swap Pool table. */
+int copyIn(support_t *supportStruct, char *dest, memaddr src, int len){
+	/* declaring local variables */
+	int frameNo; /* the pinned frame holding the page being copied */
+	int chunk; /* the number of bytes copied from the page being copied */
+
+	if (validRange(supportStruct, src, len, FALSE) == FALSE){ /* if the range does not lie within the U-proc's address space */
+		return FALSE;
+	}
+	while (len > 0){
+		chunk = PAGESIZE - (src % PAGESIZE); /* the bytes from src to the end of its page */
+		if (chunk > len){
+			chunk = len;
+		}
+		frameNo = pinUserPage(supportStruct, src); /* calling the internal helper function to pin the page */
+		copyChunk(dest, (char *) (SWAPPOOLADDR + (frameNo * PAGESIZE) + (src % PAGESIZE)), chunk); /* calling the internal helper function to copy the bytes out of the frame */
+		unpinFrame(frameNo); /* calling the internal helper function to release the pin */
+		dest += chunk;
+		src += chunk;
+		len -= chunk;
+	}
+	return TRUE;
+}
+
+/* Function that copies the len bytes in the kernel buffer src to the virtual address dest in the address space of the U-proc whose
+Support Structure is supportStruct, on behalf of a support level service. As with copyIn(), the whole range is validated first (and
+may not include a read-only .text page), and each page is then pinned while its bytes are copied into the frame holding it. The page is
+pinned with pinDmaPage(), so that a copy-on-write segment page is copied before it is stored into and the frame is marked dirty. The
+function returns TRUE if the bytes were copied and FALSE if the range is not valid (in which case nothing is copied). Note that the
+caller must not hold mutual exclusion over the Swap Pool table. */
+int copyOut(support_t *supportStruct, memaddr dest, char *src, int len){
+	/* declaring local variables */
+	int frameNo; /* the pinned frame holding the page being copied into */
+	int chunk; /* the number of bytes copied into the page being copied into */
+
+	if (validRange(supportStruct, dest, len, TRUE) == FALSE){ /* if the range does not lie within the U-proc's address space */
+		return FALSE;
+	}
+	while (len > 0){
+		chunk = PAGESIZE - (dest % PAGESIZE); /* the bytes from dest to the end of its page */
+		if (chunk > len){
+			chunk = len;
+		}
+		frameNo = pinDmaPage(supportStruct, dest, READ); /* calling the internal helper function to pin the page for storing into */
+		if (frameNo == NOFRAME){ /* if the page may not be stored into after all */
+			return FALSE;
+		}
+		copyChunk((char *) (SWAPPOOLADDR + (frameNo * PAGESIZE) + (dest % PAGESIZE)), src, chunk); /* calling the internal helper function to copy the bytes into the frame */
+		unpinDmaFrame(frameNo, READ); /* calling the internal helper function to release the pin */
+		dest += chunk;
+		src += chunk;
+		len -= chunk;
+	}
+	return TRUE;
+}
+
+/* Function that pins the pages of the U-proc whose Support Structure is supportStruct that hold the len bytes starting at the virtual
+address vAddr (other than the ones it has already pinned), on behalf of a SYS23 request. The function first reserves the pages
+against both the U-proc's quota (PINQUOTA) and the system-wide limit (PINFRAMEMAX), so that nothing is pinned if the request cannot
+be satisfied in full, and then pins each page with pinUserPage(). Pages of a shared memory segment that the U-proc attached
+copy-on-write and has not yet copied cannot be pinned, since the U-proc's first store into them replaces the frame they are mapped to.
+The function returns TRUE if the pages were pinned and FALSE otherwise. Note that the caller must have checked the range with
+validRange() and must not hold mutual exclusion over the Swap Pool table. */
+int pinRange(support_t *supportStruct, memaddr vAddr, int len){
+	/* declaring local variables */
+	int asid; /* the ASID of the U-proc pinning the pages */
+	unsigned int vpn; /* the VPN of the page being examined */
+	int pgNo; /* the logical page number of the page being examined */
+	int segNo; /* the shared memory segment whose window holds the page being examined */
+	int newCnt; /* the number of pages in the range that the U-proc has not already pinned */
+	int pinned; /* TRUE once the page being examined has been pinned (or if it was already pinned) */
+	pte_entry_t *pte;
+	int k;
+
+	asid = supportStruct->sup_asid;
+	newCnt = 0;
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	for (vpn = (vAddr & GETVPN) >> VPNSHIFT; vpn <= ((vAddr + len - 1) & GETVPN) >> VPNSHIFT; vpn++){
+		pgNo = VPNTOPGNO(vpn);
+		if (pgNo == NOPAGE){ /* if the page lies outside of the U-proc's address space */
+			mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+			return FALSE;
+		}
+		pte = findPte(supportStruct, pgNo);
+		segNo = (pgNo - SHMBASEPGNO) / SHMPGMAX;
+		if ((pgNo >= SHMBASEPGNO) && (pgNo < SHMBASEPGNO + SHMWINDOWPGS) && (supportStruct->sup_shmMode[segNo] == SHMCOW)
+			&& ((pte == (pte_entry_t *) NULL) || (((pte->entryLO) & PTECOPIEDBITON) == ALLOFF))){ /* if the page is a copy-on-write segment page that has not been copied */
+			mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+			return FALSE;
+		}
+		newCnt++;
+		for (k = 0; k < PINQUOTA; k++){
+			if (pinPgNo[asid][k] == pgNo){ /* if the U-proc has already pinned the page */
+				newCnt--;
+			}
+		}
+	}
+	if ((pinPgCnt[asid] + newCnt > PINQUOTA) || (pinTotal + newCnt > PINFRAMEMAX)){ /* if pinning the pages would exceed the U-proc's quota or the system-wide limit */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+		return FALSE;
+	}
+	pinPgCnt[asid] += newCnt; /* reserving the pages against the U-proc's quota */
+	pinTotal += newCnt; /* reserving the pages against the system-wide limit */
+	if (lcState[asid] == LCPENDING){ /* if the load control has chosen the U-proc for suspension, which a U-proc with pinned pages is exempt from */
+		lcState[asid] = LCACTIVE;
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+
+	for (vpn = (vAddr & GETVPN) >> VPNSHIFT; vpn <= ((vAddr + len - 1) & GETVPN) >> VPNSHIFT; vpn++){
+		pgNo = VPNTOPGNO(vpn);
+		pinned = FALSE;
+		for (k = 0; k < PINQUOTA; k++){
+			if (pinPgNo[asid][k] == pgNo){ /* if the U-proc has already pinned the page */
+				pinned = TRUE;
+			}
+		}
+		for (k = 0; (k < PINQUOTA) && (pinned == FALSE); k++){
+			if (pinPgNo[asid][k] == NOPAGE){ /* if the entry is free, it records the page */
+				pinFrameNo[asid][k] = pinUserPage(supportStruct, vpn << VPNSHIFT); /* calling the internal helper function to pin the page */
+				pinPgNo[asid][k] = pgNo;
+				pinned = TRUE;
+			}
+		}
+	}
+	return TRUE;
+}
+
+/* Function that releases the pins that the U-proc whose Support Structure is supportStruct holds on the pages holding the len bytes
+starting at the virtual address vAddr, on behalf of a SYS24 request. Pages in the range that the U-proc has not pinned are ignored.
+Note that the caller must have checked the range with validRange() and must not hold mutual exclusion over the Swap Pool table. */
+void unpinPages(support_t *supportStruct, memaddr vAddr, int len){
+	unsigned int vpn; /* the VPN of the page being unpinned */
+
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	for (vpn = (vAddr & GETVPN) >> VPNSHIFT; vpn <= ((vAddr + len - 1) & GETVPN) >> VPNSHIFT; vpn++){
+		if (VPNTOPGNO(vpn) != NOPAGE){ /* if the page lies within the U-proc's address space */
+			unpinRange(supportStruct->sup_asid, VPNTOPGNO(vpn), 1); /* calling the internal helper function to release the U-proc's pin on the page */
+		}
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+}
+
+/* Function that releases the pins that the U-proc whose ASID is asid holds on its pages firstPgNo through firstPgNo + cnt - 1 (which
+were taken on behalf of SYS23 requests), returning them to the U-proc's quota and to the system-wide limit. Note that the caller must
+hold mutual exclusion over the Swap Pool table. */
+void unpinRange(int asid, int firstPgNo, int cnt){
+	int k;
+
+	for (k = 0; k < PINQUOTA; k++){
+		if ((pinPgNo[asid][k] != NOPAGE) && (pinPgNo[asid][k] >= firstPgNo) && (pinPgNo[asid][k] < firstPgNo + cnt)){ /* if the U-proc has pinned a page in the range */
+			swapPoolTbl[pinFrameNo[asid][k]].pinCnt--;
+			pinPgNo[asid][k] = NOPAGE;
+			pinPgCnt[asid]--;
+			pinTotal--;
+		}
+	}
+}
+
+/* Function that removes a reverse map entry from the free list and returns a pointer to it, or NULL if the free list is empty. Note that
+the caller must hold mutual exclusion over the Swap Pool table. */
+rmap_t *allocRmap(){
+	rmap_t *r;
+
+	if (rmapFree_h == (rmap_t *) NULL){ /* if the free list is empty */
+		return (rmap_t *) NULL;
+	}
+	r = rmapFree_h;
+	rmapFree_h = r->r_next;
+	r->r_next = (rmap_t *) NULL;
+	return r;
+}
+
+/* Function that returns the reverse map entry pointed to by r to the free list. Note that the caller must hold mutual exclusion over the
+Swap Pool table. */
+void freeRmap(rmap_t *r){
+	r->r_next = rmapFree_h;
+	rmapFree_h = r;
+}
+
+/* Function that records whether frame frameNo, which is being filled with logical page pgNo of the U-proc whose Support Structure is
+supportStruct, holds a .text page that other U-procs running the same load image may share. Note that the caller must hold mutual
+exclusion over the Swap Pool table. */
+void tagFrame(int frameNo, support_t *supportStruct, int pgNo){
+	swapPoolTbl[frameNo].shareable = (pgNo < supportStruct->sup_textPgCnt); /* only pages holding nothing but .text are shared */
+	swapPoolTbl[frameNo].imageId = supportStruct->sup_imageId;
+}
+
+/* Function that searches the Swap Pool table for an idle frame holding logical page pgNo of another U-proc that runs the same load image
+as the U-proc whose Support Structure is supportStruct, where pgNo holds only .text. The function returns the number of such a frame, or
+NOFRAME if there is none. Note that the caller must hold mutual exclusion over the Swap Pool table. */
+int findSharedFrame(support_t *supportStruct, int pgNo){
+	int i;
+
+	if (pgNo >= supportStruct->sup_textPgCnt){ /* if the page does not hold only .text (or the U-proc's load image is not yet known) */
+		return NOFRAME;
+	}
+	for (i = 0; i < MAXFRAMECNT; i++){
+		if ((swapPoolTbl[i].frameState == FRAMEIDLE) && (swapPoolTbl[i].asid != EMPTYFRAME) && (swapPoolTbl[i].shareable == TRUE)
+			&& (swapPoolTbl[i].imageId == supportStruct->sup_imageId) && (swapPoolTbl[i].pgNo == pgNo)){ /* if frame i holds the same .text page of an identical load image */
+			return i;
+		}
+	}
+	return NOFRAME;
+}
+
+/* Function that invalidates the Page Table entries of every U-proc (other than the owner) sharing frame frameNo and returns their reverse
+map entries to the free list. Note that the caller must hold mutual exclusion over the Swap Pool table. */
+void unmapSharers(int frameNo){
+	rmap_t *r;
+
+	setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entries and the TLB atomically */
+	while (swapPoolTbl[frameNo].sharers != (rmap_t *) NULL){
+		r = swapPoolTbl[frameNo].sharers;
+		swapPoolTbl[frameNo].sharers = r->r_next;
+		r->r_pte->entryLO = (r->r_pte->entryLO) & VBITOFF; /* marking the sharer's entry as not valid */
+		tlbInvalidate(r->r_pte); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+		freeRmap(r);
+	}
+	setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+}
+
+/* Function that invalidates the Page Table entry with which the U-proc whose ASID is asid shares frame frameNo (if it shares the frame)
+and removes it from the frame's reverse map. Note that the caller must hold mutual exclusion over the Swap Pool table. */
+void dropSharer(int frameNo, int asid){
+	rmap_t **link; /* a pointer to the link that points to the reverse map entry being examined */
+	rmap_t *r;
+
+	link = &(swapPoolTbl[frameNo].sharers);
+	while (*link != (rmap_t *) NULL){
+		r = *link;
+		if (r->r_asid == asid){ /* if the entry belongs to the U-proc */
+			*link = r->r_next; /* unlinking the entry from the reverse map */
+			setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+			r->r_pte->entryLO = (r->r_pte->entryLO) & VBITOFF; /* marking the U-proc's entry as not valid */
+			tlbInvalidate(r->r_pte); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+			setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+			freeRmap(r);
+		}
+		else{
+			link = &(r->r_next);
+		}
+	}
+}
+
+/* Function that makes the first U-proc in the reverse map of the shared frame frameNo the frame's owner, after its owner has released
+the frame. Since shared frames hold read-only .text pages, the new owner's own flash device holds an identical copy of the page. Note
+that the caller must hold mutual exclusion over the Swap Pool table and that the frame must have at least one sharer. */
+void promoteSharer(int frameNo){
+	rmap_t *r;
+
+	r = swapPoolTbl[frameNo].sharers;
+	swapPoolTbl[frameNo].sharers = r->r_next;
+	swapPoolTbl[frameNo].asid = r->r_asid; /* the sharer becomes the frame's owner */
+	swapPoolTbl[frameNo].ownerProc = r->r_pte;
+	swapPoolTbl[frameNo].prefetched = FALSE;
+	freeRmap(r);
+}
+
+/* Function that maps frame frameNo into the U-proc whose ASID is asid through its Page Table entry pointed to by pte, with the D bit off, and
+adds the mapping to the frame's reverse map. The function returns TRUE if the frame was mapped, or FALSE if there are no reverse map
+entries left. Note that the caller must hold mutual exclusion over the Swap Pool table. */
+int addSharer(int frameNo, int asid, pte_entry_t *pte){
+	rmap_t *r;
+
+	r = allocRmap(); /* allocating a reverse map entry for the U-proc's mapping of the frame */
+	if (r == (rmap_t *) NULL){ /* if there are no free reverse map entries */
+		return FALSE;
+	}
+	r->r_asid = asid;
+	r->r_pte = pte;
+	r->r_next = swapPoolTbl[frameNo].sharers; /* adding the mapping to the frame's reverse map */
+	swapPoolTbl[frameNo].sharers = r;
+	setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+	pte->entryLO = (SWAPPOOLADDR + (frameNo * PAGESIZE)) | VBITON | ((pte->entryLO) & PTEBACKEDBITON); /* mapping the frame with the D bit off, so that the U-proc's first store raises a TLB-Modification exception */
+	tlbInvalidate(pte); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+	setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+	return TRUE;
+}
+
+/* Function that gives the U-proc whose Support Structure is supportStruct a private copy of its logical page pgNo, a page of a shared
+memory segment that it attached copy-on-write and that its Page Table entry pointed to by pte currently maps. The U-proc's mapping of
+the segment's frame is removed and the page's contents are placed in the compressed page cache (or, failing that, written to the
+U-proc's own swap slot for the page) as the U-proc's own page pgNo, so that the U-proc's next access faults in its private copy. Note that the
+caller must hold mutual exclusion over the Swap Pool table. */
+void copySegmentPage(support_t *supportStruct, int pgNo, pte_entry_t *pte){
+	/* declaring local variables */
+	int frameNo; /* the frame holding the segment page */
+	memaddr frameAddr; /* the address of the frame holding the segment page */
+	int statusCode; /* the status code returned by the flash write */
+
+	frameNo = (((pte->entryLO) & GETPFN) - SWAPPOOLADDR) / PAGESIZE; /* determining the frame holding the page from the entry's PFN */
+	frameAddr = SWAPPOOLADDR + (frameNo * PAGESIZE); /* calculating the frameNo's starting address */
+	dropSharer(frameNo, supportStruct->sup_asid); /* calling the internal helper function to remove the U-proc's mapping of the segment's frame */
+	setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry atomically */
+	pte->entryLO = (pte->entryLO) | PTECOPIEDBITON | PTEBACKEDBITON; /* recording that the page is now the U-proc's own page, whose contents are cached or on flash */
+	setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+
+	if (zcacheStore(supportStruct->sup_asid, pgNo, frameAddr) == TRUE){ /* if the copy was placed in the compressed page cache */
+		return;
+	}
+
+	swapPoolTbl[frameNo].frameState = FRAMEBUSY; /* marking the frame as in transit, so that no page fault selects it while it is copied */
+	swapPoolTbl[frameNo].evictAsid = EMPTYFRAME; /* no page is being written out of the frame, since the segment page remains mapped */
+	assignSlot(supportStruct->sup_asid, pgNo); /* calling the internal helper function to make sure that the U-proc's copy has a swap slot */
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table while the frame is written */
+	statusCode = writePage(supportStruct->sup_asid, pgNo, frameAddr); /* calling the internal helper function to write the copy to its swap slot */
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to regain mutual exclusion over the Swap Pool table */
+	releaseFrame(frameNo); /* calling the internal helper function to mark the frame as idle and wake any processes waiting on it */
+	if (statusCode != READY){ /* if the write led to an error status, the U-proc's copy is lost */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to make sure we release mutual exclusion over the Swap Pool table */
+		programTrapHandler(); /* invoking the function that handles program traps in phase 3 */
+	}
+}
+
+/* Function that attaches the shared memory segment named key to the U-proc whose Support Structure is supportStruct, in mode mode
+(SHMSHARED or SHMCOW). If no U-proc has the segment attached, a segment of pgCnt zero-filled pages is created, whose pages are swapped
+under the U-proc's ASID; otherwise the existing segment must have at least pgCnt pages. A U-proc that has already attached the segment keeps its
+original mode. The function returns the number of the segment (whose pages the U-proc finds at logical pages SHMBASEPGNO +
+segNo * SHMPGMAX onwards), or NOSEG if the segment is too small or every segment is in use. */
+int shmAttach(support_t *supportStruct, int key, int pgCnt, int mode){
+	int segNo;
+	int i;
+
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	segNo = 0;
+	while ((segNo < SHMSEGMAX) && ((shmSegTbl[segNo].key != key) || (shmSegTbl[segNo].attachCnt == 0))){ /* while segment segNo is not the attached segment named key (a segment being destroyed is never found) */
+		segNo++;
+	}
+	if (segNo == SHMSEGMAX){ /* if no U-proc has the segment attached */
+		segNo = 0;
+		while ((segNo < SHMSEGMAX) && (shmSegTbl[segNo].key != SHMNOKEY)){
+			segNo++;
+		}
+		if (segNo == SHMSEGMAX){ /* if every segment is in use */
+			mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+			return NOSEG;
+		}
+		shmSegTbl[segNo].key = key; /* creating the segment */
+		shmSegTbl[segNo].pgCnt = pgCnt;
+		shmSegTbl[segNo].backAsid = supportStruct->sup_asid; /* the segment's pages are backed by the creating U-proc's flash device */
+		for (i = 0; i < SHMPGMAX; i++){
+			shmSegTbl[segNo].pgTbl[i].entryHI = ALLOFF;
+			shmSegTbl[segNo].pgTbl[i].entryLO = ALLOFF; /* the page is neither resident nor backed by flash, so it is zero-filled on its first page fault */
+		}
+	}
+	else if (pgCnt > shmSegTbl[segNo].pgCnt){ /* if the existing segment is smaller than requested */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+		return NOSEG;
+	}
+
+	if (supportStruct->sup_shmMode[segNo] == SHMDETACHED){ /* if the U-proc has not already attached the segment */
+		shmSegTbl[segNo].attachCnt++;
+		supportStruct->sup_shmMode[segNo] = mode;
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+	return segNo;
+}
+
+/* Function that detaches the shared memory segment named key from the U-proc whose Support Structure is supportStruct. The function
+returns TRUE if the segment was detached, or FALSE if the U-proc had not attached it. */
+int shmDetach(support_t *supportStruct, int key){
+	int segNo;
+
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	segNo = 0;
+	while ((segNo < SHMSEGMAX) && ((shmSegTbl[segNo].key != key) || (shmSegTbl[segNo].attachCnt == 0) || (supportStruct->sup_shmMode[segNo] == SHMDETACHED))){ /* while segment segNo is not a segment named key that the U-proc attached */
+		segNo++;
+	}
+	if (segNo == SHMSEGMAX){ /* if the U-proc has not attached the segment */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+		return FALSE;
+	}
+	shmUnmap(supportStruct, segNo); /* calling the internal helper function to detach the segment */
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+	return TRUE;
+}
+
+/* Function that detaches every shared memory segment that the U-proc whose Support Structure is supportStruct has attached. It is
+called when the U-proc terminates. */
+void shmDetachAll(support_t *supportStruct){
+	int segNo;
+
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	for (segNo = 0; segNo < SHMSEGMAX; segNo++){
+		if (supportStruct->sup_shmMode[segNo] != SHMDETACHED){ /* if the U-proc has attached the segment */
+			shmUnmap(supportStruct, segNo); /* calling the internal helper function to detach the segment */
+		}
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+}
+
+/* Function that detaches shared memory segment segNo from the U-proc whose Support Structure is supportStruct. The U-proc's pins on the
+segment's pages are released, the U-proc's mappings of the segment's frames are removed, the private copies it made of copy-on-write pages are discarded, and its Page Table entries for the
+segment's pages are reset. The segment is destroyed if no other U-proc has it attached. Note that the caller must hold mutual exclusion
+over the Swap Pool table. */
+void shmUnmap(support_t *supportStruct, int segNo){
+	/* declaring local variables */
+	int asid; /* the ASID of the U-proc detaching the segment */
+	int firstPgNo; /* the first logical page at which the segment is mapped */
+	int frameNo;
+	pte_entry_t *pte;
+	int i;
+
+	asid = supportStruct->sup_asid;
+	firstPgNo = SHMBASEPGNO + (segNo * SHMPGMAX);
+	waitForWriteBack(asid, firstPgNo, SHMPGMAX); /* calling the internal helper function to wait until no private copy of one of the segment's pages is being written */
+	unpinRange(asid, firstPgNo, SHMPGMAX); /* calling the internal helper function to release the U-proc's pins on the segment's pages */
+	for (frameNo = 0; frameNo < MAXFRAMECNT; frameNo++){
+		if ((swapPoolTbl[frameNo].asid == asid) && (swapPoolTbl[frameNo].segNo == NOSEG) && (swapPoolTbl[frameNo].pgNo >= firstPgNo)
+			&& (swapPoolTbl[frameNo].pgNo < firstPgNo + SHMPGMAX)){ /* if the frame holds a private copy of one of the segment's pages */
+			swapPoolTbl[frameNo].asid = EMPTYFRAME; /* returning the frame to the Swap Pool as unoccupied */
+			swapPoolTbl[frameNo].dirty = FALSE;
+		}
+		if ((swapPoolTbl[frameNo].asid != EMPTYFRAME) && (swapPoolTbl[frameNo].segNo == segNo)){ /* if the frame holds one of the segment's pages */
+			dropSharer(frameNo, asid); /* calling the internal helper function to remove the U-proc's mapping of the frame */
+		}
+	}
+	for (i = 0; i < ZENTRYCNT; i++){
+		if ((zcacheTbl[i].state == ZCACHED) && (zcacheTbl[i].asid == asid) && (zcacheTbl[i].pgNo >= firstPgNo) && (zcacheTbl[i].pgNo < firstPgNo + SHMPGMAX)){ /* if the entry holds a private copy of one of the segment's pages */
+			zcacheDrop(i); /* calling the internal helper function to remove the page from the compressed page cache */
+		}
+	}
+	freeSlots(asid, firstPgNo, SHMPGMAX); /* calling the internal helper function to reclaim the swap slots of the U-proc's private copies */
+	for (i = 0; i < SHMPGMAX; i++){
+		pte = findPte(supportStruct, firstPgNo + i);
+		if (pte != (pte_entry_t *) NULL){ /* if the table holding the entry has been allocated */
+			setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+			pte->entryLO = ALLOFF | DBITON; /* resetting the entry to its initial state */
+			tlbInvalidate(pte); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+			setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+		}
+	}
+
+	supportStruct->sup_shmMode[segNo] = SHMDETACHED;
+	shmSegTbl[segNo].attachCnt--;
+	if (shmSegTbl[segNo].attachCnt == 0){ /* if no U-proc has the segment attached any longer */
+		shmDestroy(segNo); /* calling the internal helper function to free the segment */
+	}
+}
+
+/* Function that frees shared memory segment segNo, which no U-proc has attached: the frames holding its pages are returned to the Swap
+Pool as unoccupied (once any transfers in progress complete), its cached pages are discarded, and the segment is marked as unused. Note
+that the caller must hold mutual exclusion over the Swap Pool table. */
+void shmDestroy(int segNo){
+	int frameNo;
+	int i;
+
+	waitForWriteBack(shmSegTbl[segNo].backAsid, SHMBLOCKBASE + (segNo * SHMPGMAX), SHMPGMAX); /* calling the internal helper function to wait until none of the segment's pages is in transit */
+	for (frameNo = 0; frameNo < MAXFRAMECNT; frameNo++){
+		if ((swapPoolTbl[frameNo].asid != EMPTYFRAME) && (swapPoolTbl[frameNo].segNo == segNo)){ /* if the frame holds one of the segment's pages */
+			swapPoolTbl[frameNo].asid = EMPTYFRAME; /* returning the frame to the Swap Pool as unoccupied */
+			swapPoolTbl[frameNo].segNo = NOSEG;
+			swapPoolTbl[frameNo].dirty = FALSE;
+		}
+	}
+	for (i = 0; i < ZENTRYCNT; i++){
+		if ((zcacheTbl[i].state == ZCACHED) && (zcacheTbl[i].asid == shmSegTbl[segNo].backAsid) && (zcacheTbl[i].pgNo >= SHMBLOCKBASE + (segNo * SHMPGMAX))
+			&& (zcacheTbl[i].pgNo < SHMBLOCKBASE + ((segNo + 1) * SHMPGMAX))){ /* if the entry holds one of the segment's pages */
+			zcacheDrop(i); /* calling the internal helper function to remove the page from the compressed page cache */
+		}
+	}
+	freeSlots(shmSegTbl[segNo].backAsid, SHMBLOCKBASE + (segNo * SHMPGMAX), SHMPGMAX); /* calling the internal helper function to reclaim the swap slots of the segment's pages */
+	shmSegTbl[segNo].key = SHMNOKEY; /* the segment may now be reused */
+}
+
+/* Function that returns the mapped region of the U-proc whose ASID is asid that holds its logical page pgNo, or NOREGION if the page
+does not lie in a region that the U-proc has mapped. */
+int mmapFind(int asid, int pgNo){
+	int regionNo;
+
+	if ((pgNo < MMAPBASEPGNO) || (pgNo >= MMAPBASEPGNO + MMAPWINDOWPGS)){ /* if the page lies outside of the mapped region window */
+		return NOREGION;
+	}
+	regionNo = (pgNo - MMAPBASEPGNO) / MMAPPGMAX;
+	if (((pgNo - MMAPBASEPGNO) % MMAPPGMAX) >= mmapTbl[asid][regionNo].pgCnt){ /* if the region is unused or the page lies beyond its end */
+		return NOREGION;
+	}
+	return regionNo;
+}
+
+/* Function that maps the pgCnt blocks of flash device devNo starting at block firstBlock into the address space of the U-proc whose
+Support Structure is supportStruct, as one of its mapped regions. The region's pages are brought in by the Pager from the blocks they
+map on their first access, and dirty pages are written back to them when they are evicted or when the region is synced or unmapped.
+The function returns the number of the region (whose pages the U-proc finds at logical pages MMAPBASEPGNO + regionNo * MMAPPGMAX
+onwards), or NOREGION if the blocks lie beyond the end of the device or if the U-proc has already mapped MMAPMAX regions. Note that
+regions mapped by different U-procs are not kept coherent with one another. */
+int mmapMap(support_t *supportStruct, int devNo, int firstBlock, int pgCnt){
+	/* declaring local variables */
+	devregarea_t *temp; /* device register area that we can use to read the number of blocks of flash device devNo */
+	int asid; /* the ASID of the U-proc mapping the blocks */
+	int regionNo;
+
+	temp = (devregarea_t *) RAMBASEADDR; /* initialization of temp */
+	if (firstBlock + pgCnt > temp->devreg[((FLASHINT - OFFSET) * DEVPERINT) + devNo].d_data1){ /* if the blocks lie beyond the end of the device (whose DATA1 field holds its number of blocks) */
+		return NOREGION;
+	}
+
+	asid = supportStruct->sup_asid;
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	regionNo = 0;
+	while ((regionNo < MMAPMAX) && (mmapTbl[asid][regionNo].pgCnt != 0)){
+		regionNo++;
+	}
+	if (regionNo < MMAPMAX){ /* if the U-proc has an unused region */
+		mmapTbl[asid][regionNo].devNo = devNo;
+		mmapTbl[asid][regionNo].firstBlock = firstBlock;
+		mmapTbl[asid][regionNo].pgCnt = pgCnt;
+	}
+	else{
+		regionNo = NOREGION;
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+	return regionNo;
+}
+
+/* Function that determines whether any U-proc has mapped blocks of flash device devNo into its address space, so that a SYS16 or SYS17
+request can be refused the device instead of bypassing the copies of the blocks that the mapping U-proc holds in the Swap Pool. The
+function returns TRUE if some U-proc has a region mapped on the device and FALSE otherwise. Note that the caller must not hold mutual
+exclusion over the Swap Pool table. */
+int mmapDevMapped(int devNo){
+	int mapped; /* TRUE once a region mapped on the device has been found */
+	int i;
+
+	mapped = FALSE;
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	for (i = 0; i < (UPROCMAX + 1) * MMAPMAX; i++){
+		if ((mmapTbl[i / MMAPMAX][i % MMAPMAX].pgCnt != 0) && (mmapTbl[i / MMAPMAX][i % MMAPMAX].devNo == devNo)){ /* if the region is in use and maps blocks of the device */
+			mapped = TRUE;
+		}
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+	return mapped;
+}
+
+/* Function that writes the dirty pages of mapped region regionNo of the U-proc whose ASID is asid back to the flash blocks they map. Each
+dirty page is written the way the page cleaner writes a frame: the frame is marked as in transit and clean and the page's D bit is turned
+off, so that a store performed while the write is in progress marks the frame as dirty once again. The function also waits for any of
+the region's pages that are being written out by the Pager, so that every store performed before the call is on flash when it returns.
+The function returns READY, or the status code of the first write that failed. Note that the caller must hold mutual exclusion over the
+Swap Pool table. */
+int syncRegion(int asid, int regionNo){
+	/* declaring local variables */
+	int firstPgNo; /* the first logical page at which the region is mapped */
+	int frameNo;
+	int statusCode; /* the status code returned by the flash write */
+	int result; /* the status code that the function returns */
+
+	firstPgNo = MMAPBASEPGNO + (regionNo * MMAPPGMAX);
+	result = READY;
+	waitForWriteBack(asid, firstPgNo, MMAPPGMAX); /* calling the internal helper function to wait until none of the region's pages is in transit */
+	for (frameNo = 0; frameNo < MAXFRAMECNT; frameNo++){
+		if ((swapPoolTbl[frameNo].asid == asid) && (swapPoolTbl[frameNo].segNo == NOSEG) && (swapPoolTbl[frameNo].pgNo >= firstPgNo)
+			&& (swapPoolTbl[frameNo].pgNo < firstPgNo + MMAPPGMAX) && (swapPoolTbl[frameNo].frameState == FRAMEIDLE) && (swapPoolTbl[frameNo].dirty == TRUE)){ /* if the frame holds a dirty page of the region */
+			swapPoolTbl[frameNo].frameState = FRAMEBUSY; /* marking the frame as in transit, so that no page fault selects it */
+			swapPoolTbl[frameNo].evictAsid = EMPTYFRAME; /* no page is being written out of the frame, since the page remains mapped */
+			swapPoolTbl[frameNo].dirty = FALSE; /* the frame will be clean once the write completes, unless it is modified in the meantime */
+			setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+			swapPoolTbl[frameNo].ownerProc->entryLO = (swapPoolTbl[frameNo].ownerProc->entryLO) & DBITOFF; /* turning the D bit off */
+			tlbInvalidate(swapPoolTbl[frameNo].ownerProc); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+			setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+			mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table while the frame is written */
+			statusCode = writePage(asid, swapPoolTbl[frameNo].pgNo, SWAPPOOLADDR + (frameNo * PAGESIZE)); /* calling the internal helper function to write the page to the block it maps */
+			mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to regain mutual exclusion over the Swap Pool table */
+			if (statusCode != READY){ /* if the write led to an error status */
+				swapPoolTbl[frameNo].dirty = TRUE; /* the frame is still dirty */
+				if (result == READY){
+					result = statusCode;
+				}
+			}
+			releaseFrame(frameNo); /* calling the internal helper function to mark the frame as idle and wake any processes waiting on it */
+		}
+	}
+	waitForWriteBack(asid, firstPgNo, MMAPPGMAX); /* calling the internal helper function to wait for any of the region's pages that the Pager evicted in the meantime */
+	return result;
+}
+
+/* Function that writes the dirty pages of mapped region regionNo of the U-proc whose Support Structure is supportStruct back to flash, on
+behalf of a SYS26 request. The function returns READY, or the status code of the first write that failed (or NOREGION if the U-proc has
+not mapped the region). */
+int mmapSync(support_t *supportStruct, int regionNo){
+	int result;
+
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	if (mmapTbl[supportStruct->sup_asid][regionNo].pgCnt == 0){ /* if the U-proc has not mapped the region */
+		result = NOREGION;
+	}
+	else{
+		result = syncRegion(supportStruct->sup_asid, regionNo); /* calling the internal helper function to write the region's dirty pages back */
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+	return result;
+}
+
+/* Function that unmaps mapped region regionNo of the U-proc whose Support Structure is supportStruct. The region's dirty pages are first
+written back to flash, the U-proc's pins on the region's pages are released, the frames holding them are returned to the Swap Pool as
+unoccupied and the corresponding Page Table entries are reset, so that the region may be reused. The function returns READY, or the
+status code of the first write that failed (in which case the page's modifications are lost). Note that the caller must hold mutual
+exclusion over the Swap Pool table. */
+int unmapRegion(support_t *supportStruct, int regionNo){
+	/* declaring local variables */
+	int asid; /* the ASID of the U-proc unmapping the region */
+	int firstPgNo; /* the first logical page at which the region is mapped */
+	int result; /* the status code that the function returns */
+	int frameNo;
+	pte_entry_t *pte;
+	int i;
+
+	asid = supportStruct->sup_asid;
+	firstPgNo = MMAPBASEPGNO + (regionNo * MMAPPGMAX);
+	result = syncRegion(asid, regionNo); /* calling the internal helper function to write the region's dirty pages back */
+	unpinRange(asid, firstPgNo, MMAPPGMAX); /* calling the internal helper function to release the U-proc's pins on the region's pages */
+	for (frameNo = 0; frameNo < MAXFRAMECNT; frameNo++){
+		if ((swapPoolTbl[frameNo].asid == asid) && (swapPoolTbl[frameNo].segNo == NOSEG) && (swapPoolTbl[frameNo].pgNo >= firstPgNo)
+			&& (swapPoolTbl[frameNo].pgNo < firstPgNo + MMAPPGMAX)){ /* if the frame holds one of the region's pages */
+			swapPoolTbl[frameNo].asid = EMPTYFRAME; /* returning the frame to the Swap Pool as unoccupied */
+			swapPoolTbl[frameNo].prefetched = FALSE;
+			swapPoolTbl[frameNo].dirty = FALSE;
+		}
+	}
+	for (i = 0; i < MMAPPGMAX; i++){
+		pte = findPte(supportStruct, firstPgNo + i);
+		if (pte != (pte_entry_t *) NULL){ /* if the table holding the entry has been allocated */
+			setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+			pte->entryLO = ALLOFF | DBITON; /* resetting the entry to its initial state */
+			tlbInvalidate(pte); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+			setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+		}
+	}
+	mmapTbl[asid][regionNo].pgCnt = 0; /* the region may now be reused */
+	return result;
+}
+
+/* Function that unmaps mapped region regionNo of the U-proc whose Support Structure is supportStruct, on behalf of a SYS27 request. The
+function returns READY, or the status code of the first write that failed (or NOREGION if the U-proc has not mapped the region). */
+int mmapUnmap(support_t *supportStruct, int regionNo){
+	int result;
+
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	if (mmapTbl[supportStruct->sup_asid][regionNo].pgCnt == 0){ /* if the U-proc has not mapped the region */
+		result = NOREGION;
+	}
+	else{
+		result = unmapRegion(supportStruct, regionNo); /* calling the internal helper function to unmap the region */
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+	return result;
+}
+
+/* Function that unmaps every region that the U-proc whose Support Structure is supportStruct has mapped, writing their dirty pages back
+to flash. The function is called when the U-proc terminates. */
+void mmapUnmapAll(support_t *supportStruct){
+	int regionNo;
+
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	for (regionNo = 0; regionNo < MMAPMAX; regionNo++){
+		if (mmapTbl[supportStruct->sup_asid][regionNo].pgCnt != 0){ /* if the U-proc has mapped the region */
+			unmapRegion(supportStruct, regionNo); /* calling the internal helper function to unmap the region */
+		}
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+}
+
+/* Function that returns the number of consecutive words, starting at word wordNo of the page page, that are identical to word wordNo. */
+int runLength(unsigned int *page, int wordNo){
+	int i;
+
+	i = wordNo + 1;
+	while ((i < PAGESIZE / WORDLEN) && (page[i] == page[wordNo])){
+		i++;
+	}
+	return i - wordNo;
+}
+
+/* Function that compresses the page page into the buffer dest. The compressed page is a sequence of tokens, each of which begins with
+a header word. If the header word's ZRUNBIT is on, the token represents a run of (header & ZCOUNTMASK) copies of the single word that
+follows the header; otherwise, the token represents the (header & ZCOUNTMASK) words that follow the header, copied as they are. Only
+runs of at least ZMINRUN identical words are encoded as runs. The function returns the number of words in the compressed page, or
+NOZENTRY if the page does not compress to ZMAXWORDS words or less (in which case the contents of dest are meaningless). */
+int compressPage(unsigned int *page, unsigned int *dest){
+	/* declaring local variables */
+	int wordNo; /* the word of the page being compressed */
+	int destLen; /* the number of words written to dest */
+	int runLen; /* the length of the run of identical words starting at wordNo */
+	int litStart; /* the word of the page at which a sequence of words copied as they are begins */
+
+	wordNo = 0;
+	destLen = 0;
+	while (wordNo < PAGESIZE / WORDLEN){
+		runLen = runLength(page, wordNo);
+		if (runLen >= ZMINRUN){ /* if the run is long enough to be encoded as a run */
+			if (destLen + 2 > ZMAXWORDS){ /* if the page does not compress well enough */
+				return NOZENTRY;
+			}
+			dest[destLen++] = ZRUNBIT | runLen;
+			dest[destLen++] = page[wordNo];
+			wordNo += runLen;
+		}
+		else{ /* copying words as they are until the next run that is long enough to be encoded */
+			litStart = wordNo;
+			while ((wordNo < PAGESIZE / WORDLEN) && (runLength(page, wordNo) < ZMINRUN)){
+				wordNo++;
+			}
+			if (destLen + 1 + (wordNo - litStart) > ZMAXWORDS){ /* if the page does not compress well enough */
+				return NOZENTRY;
+			}
+			dest[destLen++] = wordNo - litStart;
+			while (litStart < wordNo){
+				dest[destLen++] = page[litStart++];
+			}
+		}
+	}
+	return destLen;
+}
+
+/* Function that decompresses the compressed page src (as produced by compressPage()) into the page page. */
+void decompressPage(unsigned int *src, unsigned int *page){
+	/* declaring local variables */
+	int wordNo; /* the word of the page being written */
+	int cnt; /* the number of words represented by the current token */
+
+	wordNo = 0;
+	while (wordNo < PAGESIZE / WORDLEN){
+		cnt = (*src) & ZCOUNTMASK;
+		if (((*src) & ZRUNBIT) != ALLOFF){ /* if the token represents a run of identical words */
+			while (cnt > 0){
+				page[wordNo++] = src[1];
+				cnt--;
+			}
+			src += 2;
+		}
+		else{ /* the token's words are copied as they are */
+			src++;
+			while (cnt > 0){
+				page[wordNo++] = *(src++);
+				cnt--;
+			}
+		}
+	}
+}
+
+/* Function that returns the entry of the compressed page cache that holds logical page pgNo of the U-proc whose ASID is asid, or
+NOZENTRY if the page is not cached. Note that the caller must hold mutual exclusion over the Swap Pool table. */
+int zcacheFind(int asid, int pgNo){
+	int i;
+	for (i = 0; i < ZENTRYCNT; i++){
+		if ((zcacheTbl[i].state != ZFREE) && (zcacheTbl[i].asid == asid) && (zcacheTbl[i].pgNo == pgNo)){
+			return i;
+		}
+	}
+	return NOZENTRY;
+}
+
+/* Function that copies the compressed page held by entry entryNo of the compressed page cache from its chunks into the scratch buffer,
+so that it can be decompressed. Note that the caller must hold mutual exclusion over the Swap Pool table. */
+void zcacheGather(int entryNo){
+	int i;
+	int chunk; /* the chunk being copied */
+
+	chunk = zcacheTbl[entryNo].firstChunk;
+	for (i = 0; i < zcacheTbl[entryNo].wordCnt; i++){
+		zScratch[i] = ((unsigned int *) (ZCACHEADDR + (chunk * ZCHUNKWORDS * WORDLEN)))[i % ZCHUNKWORDS];
+		if ((i % ZCHUNKWORDS) == (ZCHUNKWORDS - 1)){ /* if the last word of the chunk has been copied */
+			chunk = zNextChunk[chunk];
+		}
+	}
+}
+
+/* Function that removes the page held by entry entryNo from the compressed page cache, returning its chunks to the list of free chunks.
+Note that the caller must hold mutual exclusion over the Swap Pool table. */
+void zcacheDrop(int entryNo){
+	int chunk;
+	int nextChunk;
+
+	chunk = zcacheTbl[entryNo].firstChunk;
+	while (chunk != NOCHUNK){
+		nextChunk = zNextChunk[chunk];
+		zNextChunk[chunk] = zFreeHead; /* placing the chunk at the head of the list of free chunks */
+		zFreeHead = chunk;
+		zFreeChunks++;
+		chunk = nextChunk;
+	}
+	zcacheTbl[entryNo].state = ZFREE;
+}
+
+/* Function that attempts to place logical page pgNo of the U-proc whose ASID is asid, which is being evicted from the frame whose starting
+address is frameAddr, in the compressed page cache. The function returns TRUE if the page was cached, and FALSE if the page does not
+compress well enough, if there is not enough free space in the cache or if the page belongs to a mapped region (in which case the
+caller must write the page to flash). Note
+that the caller must hold mutual exclusion over the Swap Pool table and that the page must no longer be mapped. */
+int zcacheStore(int asid, int pgNo, memaddr frameAddr){
+	/* declaring local variables */
+	int entryNo; /* the entry of the compressed page cache that will hold the page */
+	int wordCnt; /* the number of words in the compressed page */
+	int chunk; /* the chunk being filled */
+	int i;
+
+	if (mmapFind(asid, pgNo) != NOREGION){ /* if the page belongs to a mapped region, which must be written back to the flash it maps */
+		return FALSE;
+	}
+	wordCnt = compressPage((unsigned int *) frameAddr, zScratch); /* calling the internal helper function to compress the page */
+	if ((wordCnt == NOZENTRY) || (((wordCnt + ZCHUNKWORDS - 1) / ZCHUNKWORDS) > zFreeChunks)){ /* if the page does not compress well enough or does not fit */
+		return FALSE;
+	}
+	entryNo = 0;
+	while ((entryNo < ZENTRYCNT) && (zcacheTbl[entryNo].state != ZFREE)){
+		entryNo++;
+	}
+	if (entryNo == ZENTRYCNT){ /* if every entry of the compressed page cache is in use */
+		return FALSE;
+	}
+
+	/* removing chunks from the list of free chunks and copying the compressed page into them */
+	zcacheTbl[entryNo].firstChunk = zFreeHead;
+	chunk = zFreeHead;
+	for (i = 0; i < wordCnt; i++){
+		((unsigned int *) (ZCACHEADDR + (chunk * ZCHUNKWORDS * WORDLEN)))[i % ZCHUNKWORDS] = zScratch[i];
+		if (((i % ZCHUNKWORDS) == (ZCHUNKWORDS - 1)) && (i != wordCnt - 1)){ /* if the chunk is full and there are words left to copy */
+			chunk = zNextChunk[chunk];
+		}
+		zFreeChunks -= (((i % ZCHUNKWORDS) == 0) ? 1 : 0); /* counting each chunk as it is first written */
+	}
+	zFreeHead = zNextChunk[chunk]; /* the chunks following the last one used remain free */
+	zNextChunk[chunk] = NOCHUNK; /* terminating the page's list of chunks */
+
+	zcacheTbl[entryNo].state = ZCACHED;
+	zcacheTbl[entryNo].asid = asid;
+	zcacheTbl[entryNo].pgNo = pgNo;
+	zcacheTbl[entryNo].wordCnt = wordCnt;
+	zcacheTbl[entryNo].seqNo = zSeqNo++;
+	return TRUE;
+}
+
+/* Function that attempts to satisfy a page fault on logical page pgNo of the U-proc whose ASID is asid from the compressed page cache,
+by decompressing the page into the frame whose starting address is frameAddr and removing it from the cache. If the page cleaner is
+currently writing the page back to flash, the function first waits for the write to complete (after which the page is no longer
+cached). The function returns TRUE if the page was decompressed into the frame, and FALSE if the page is not cached. Note that the
+caller must hold mutual exclusion over the Swap Pool table, which is released while the caller waits and is held again when the
+function returns. */
+int zcacheLoad(int asid, int pgNo, memaddr frameAddr){
+	int entryNo;
+
+	entryNo = zcacheFind(asid, pgNo);
+	while ((entryNo != NOZENTRY) && (zcacheTbl[entryNo].state == ZWRITING)){ /* while the page cleaner is writing the page back to flash */
+		zWaitCnt++; /* registering the calling process as a waiter on the write */
+		mutex(FALSE, (int *) &swapSem); /* releasing mutual exclusion over the Swap Pool table while we wait */
+		mutex(TRUE, (int *) &zWriteSem); /* performing a P operation on the write's synchronization semaphore until it completes */
+		mutex(TRUE, (int *) &swapSem); /* regaining mutual exclusion over the Swap Pool table */
+		entryNo = zcacheFind(asid, pgNo);
+	}
+	if (entryNo == NOZENTRY){ /* if the page is not cached */
+		return FALSE;
+	}
+	zcacheGather(entryNo); /* calling the internal helper function to copy the compressed page into the scratch buffer */
+	decompressPage(zScratch, (unsigned int *) frameAddr); /* calling the internal helper function to decompress the page into the frame */
+	zcacheDrop(entryNo); /* calling the internal helper function to remove the page from the compressed page cache */
+	return TRUE;
+}
+
+/* Function that is called by the page cleaner daemon to write the oldest pages in the compressed page cache back to flash, until at
+least ZCLEANCHUNKS chunks are free. Each page is decompressed into the bounce page (which only the page cleaner uses) and marked as
+being written, so that a page fault on it waits for the write to complete; the page remains in the cache (and its chunks remain
+allocated) until the write completes. If the write fails, the page is left in the cache. Note that the caller must hold mutual
+exclusion over the Swap Pool table, which is released during each write and is held again when the function returns. */
+void zcacheWriteBack(){
+	/* declaring local variables */
+	int entryNo; /* the entry holding the oldest cached page */
+	int i;
+	int statusCode; /* the status code returned by the flash write */
+
+	while (zFreeChunks < ZCLEANCHUNKS){ /* while the compressed page cache is nearly full */
+		entryNo = NOZENTRY;
+		for (i = 0; i < ZENTRYCNT; i++){
+			if ((zcacheTbl[i].state == ZCACHED) && ((entryNo == NOZENTRY) || (zcacheTbl[i].seqNo < zcacheTbl[entryNo].seqNo))){
+				entryNo = i;
+			}
+		}
+		if (entryNo == NOZENTRY){ /* if there are no cached pages left to write back */
+			return;
+		}
+
+		zcacheGather(entryNo); /* calling the internal helper function to copy the compressed page into the scratch buffer */
+		decompressPage(zScratch, (unsigned int *) ZBOUNCEADDR); /* calling the internal helper function to decompress the page into the bounce page */
+		zcacheTbl[entryNo].state = ZWRITING; /* marking the page as being written, so that page faults on it wait */
+		assignSlot(zcacheTbl[entryNo].asid, zcacheTbl[entryNo].pgNo); /* calling the internal helper function to make sure that the page has a swap slot */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table while the page is written */
+		statusCode = writePage(zcacheTbl[entryNo].asid, zcacheTbl[entryNo].pgNo, ZBOUNCEADDR); /* calling the internal helper function to write the page to its swap slot */
+		mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to regain mutual exclusion over the Swap Pool table */
+
+		if (statusCode == READY){ /* if the page was written successfully */
+			zcacheDrop(entryNo); /* calling the internal helper function to remove the page from the compressed page cache */
+		}
+		else{ /* the write led to an error status, so the page is left in the cache */
+			zcacheTbl[entryNo].state = ZCACHED;
+		}
+		while (zWaitCnt > 0){ /* while there is a process waiting for the write to complete */
+			zWaitCnt--;
+			mutex(FALSE, (int *) &zWriteSem); /* performing a V operation on the write's synchronization semaphore to unblock one waiting process */
+		}
+		if (statusCode != READY){ /* if the write failed, the remaining pages are left for the next pass */
+			return;
+		}
+	}
+}
+
+/* Function that returns TRUE if the U-proc with Support Structure supportStruct may store into the word at vAddr without raising a page
+fault or a TLB-Modification exception (i.e., if the page's Page Table entry has both its V and D bits on). The function takes no locks,
+so that it may be called with interrupts disabled; the answer holds for as long as they stay disabled. */
+int pageWritable(support_t *supportStruct, memaddr vAddr){
+	/* declaring local variables */
+	int pgNo; /* the logical page number of the page holding vAddr */
+	pte_entry_t *pte; /* a pointer to the U-proc's Page Table entry for the page */
+
+	pgNo = VPNTOPGNO((vAddr & GETVPN) >> VPNSHIFT); /* translating vAddr's VPN into a logical page number */
+	if (pgNo == NOPAGE){ /* if vAddr lies outside the U-proc's address space */
+		return FALSE;
+	}
+	pte = findPte(supportStruct, pgNo); /* locating the U-proc's Page Table entry for the page */
+	return ((pte != (pte_entry_t *) NULL) && (((pte->entryLO) & VBITON) != ALLOFF) && (((pte->entryLO) & DBITON) != ALLOFF));
+}
+
+/* Function that prepares the page holding vAddr so that the U-proc with Support Structure supportStruct can store into it with
+interrupts disabled (see pageWritable()). The function reads the byte at vAddr (which raises a page fault if the page is not resident)
+and then does what handleTlbMod() would do for a store: it gives the U-proc its own copy of a copy-on-write segment page, or turns the
+D bit on and marks the frame dirty. The function returns FALSE if vAddr lies outside the U-proc's address space or in one of its
+read-only .text pages. Since the page may be evicted again as soon as the Swap Pool semaphore is released, the caller retries until
+pageWritable() returns TRUE. */
+int makeWritable(support_t *supportStruct, memaddr vAddr){
+	/* declaring local variables */
+	volatile char *touch; /* a pointer through which the function reads the byte at vAddr, which need not be word-aligned */
+	int pgNo; /* the logical page number of the page holding vAddr */
+	pte_entry_t *pte; /* a pointer to the U-proc's Page Table entry for the page */
+	int frameNo; /* the frame holding the page */
+
+	pgNo = VPNTOPGNO((vAddr & GETVPN) >> VPNSHIFT); /* translating vAddr's VPN into a logical page number */
+	if (pgNo == NOPAGE){ /* if vAddr lies outside the U-proc's address space */
+		return FALSE;
+	}
+	touch = (volatile char *) vAddr;
+	(void) *touch; /* reading the byte at vAddr, which raises a page fault if the page is not resident */
+	if (pgNo < supportStruct->sup_textPgCnt){ /* if the page is one of the U-proc's read-only .text pages (known once the page has been read) */
+		return FALSE;
+	}
+
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	pte = findPte(supportStruct, pgNo); /* locating the U-proc's Page Table entry for the page */
+	if ((pte != (pte_entry_t *) NULL) && (((pte->entryLO) & VBITON) != ALLOFF) && (((pte->entryLO) & DBITON) == ALLOFF)){ /* if the page is resident but a store would raise a TLB-Modification exception */
+		if ((pgNo >= SHMBASEPGNO) && (pgNo < LOWPGMAX) && (((pte->entryLO) & PTECOPIEDBITON) == ALLOFF)
+			&& (supportStruct->sup_shmMode[(pgNo - SHMBASEPGNO) / SHMPGMAX] == SHMCOW)){ /* if the page belongs to a segment attached copy-on-write */
+			copySegmentPage(supportStruct, pgNo, pte); /* calling the internal helper function to give the U-proc a private copy of the page, which the caller's retry faults in */
+		}
+		else{
+			frameNo = (((pte->entryLO) & GETPFN) - SWAPPOOLADDR) / PAGESIZE; /* determining the frame holding the page from the entry's PFN */
+			swapPoolTbl[frameNo].dirty = TRUE; /* marking the frame as dirty, since the caller is about to modify its page */
+			setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+			pte->entryLO = (pte->entryLO) | DBITON; /* turning the D bit on, so that the caller's store does not raise an exception */
+			tlbInvalidate(pte); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+			setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+		}
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+	return TRUE;
+}
+
+/* Function that handles TLB-Modification exceptions, which are raised when a U-proc first stores into a page whose Page Table entry
+has its D bit off. If the page is still valid, the function turns the entry's D bit on and marks the frame holding the page as dirty,
+so that the page is written back to flash when it is evicted; otherwise, the page was evicted after the exception was raised, and the
+instruction is simply retried (and will raise a page fault). In both cases, control is then returned to the Current Process. A store
+into one of the Current Process' .text pages, which are read-only (and may be shared), is treated as a Program Trap, while a store into
+a page of a shared memory segment that the Current Process attached copy-on-write gives it a private copy of the page. */
+void handleTlbMod(support_t *curProcSupportStruct, state_PTR savedState){
+	/* declaring local variables */
+	int pgNo; /* the page number of the page that was stored into */
+	pte_entry_t *pte; /* a pointer to the Current Process' Page Table entry for the page that was stored into */
+	int frameNo; /* the frame number holding the page that was stored into */
+
+	pgNo = VPNTOPGNO(((savedState->s_entryHI) & GETVPN) >> VPNSHIFT); /* translating the VPN in the saved exception state's EntryHI field into a logical page number */
+	pte = (pte_entry_t *) NULL;
+
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+	if (pgNo != NOPAGE){ /* if the page lies inside the Current Process' address space */
+		pte = findPte(curProcSupportStruct, pgNo); /* initializing pte to the Current Process' Page Table entry for the page */
+	}
+	if ((pgNo != NOPAGE) && (pgNo < curProcSupportStruct->sup_textPgCnt)){ /* if the Current Process stored into one of its read-only .text pages */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+		programTrapHandler(); /* invoking the function that handles Program Traps in phase 3 */
+	}
+	if ((pte != (pte_entry_t *) NULL) && (((pte->entryLO) & VBITON) != ALLOFF) && (pgNo >= SHMBASEPGNO) && (pgNo < LOWPGMAX) && (((pte->entryLO) & PTECOPIEDBITON) == ALLOFF)
+		&& (curProcSupportStruct->sup_shmMode[(pgNo - SHMBASEPGNO) / SHMPGMAX] == SHMCOW)){ /* if the Current Process stored into a page of a segment that it attached copy-on-write */
+		copySegmentPage(curProcSupportStruct, pgNo, pte); /* calling the internal helper function to give the Current Process a private copy of the page, which the retried store faults in */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+		switchUContext(savedState); /* returning control to the Current Process to retry the store */
+	}
+	if ((pte != (pte_entry_t *) NULL) && (((pte->entryLO) & VBITON) != ALLOFF)){ /* if the page is still resident */
+		frameNo = (((pte->entryLO) & GETPFN) - SWAPPOOLADDR) / PAGESIZE; /* determining the frame holding the page from the entry's PFN */
+		swapPoolTbl[frameNo].dirty = TRUE; /* marking the frame as dirty, since its page has been modified */
+		setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+		pte->entryLO = (pte->entryLO) | DBITON; /* turning the D bit on, so that further stores into the page do not raise an exception */
+		tlbInvalidate(pte); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+		setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+	switchUContext(savedState); /* returning control to the Current Process to retry the store */
+}
+
+/* Function that initializes the Swap Pool table and the Swap Pool semaphore (i.e., the variables that are global
+to this module), along with the read-ahead state of each U-proc. Since the Swap Pool semaphore is used for mutual exclusion, the function initializes the semaphore to 1,
+and the function initializes every entry's ASID in the Swap Pool table to -1, since none of the frames in the Swap Pool
+are curretly occupied (or in transit). */
+void initSwapStructs(){
+	swapSem = 1; /* initializing the Swap Pool semaphore to 1, since it will be used for the purpose of mutual exclusion */
+
+	/* initializing the Swap Pool table */
+	int i;
+	for (i = 0; i < MAXFRAMECNT; i++){
+		swapPoolTbl[i].asid = EMPTYFRAME; /* initializing the ASID to -1, since all frames are currently unoccupied */
+		swapPoolTbl[i].frameState = FRAMEIDLE; /* initializing the frame's state, since no frame is currently in transit */
+		swapPoolTbl[i].evictAsid = EMPTYFRAME; /* initializing the ASID of the page being written out of the frame, since no page is being written out */
+		swapPoolTbl[i].frameSem = INITIALFRAMESEM; /* initializing the frame's semaphore to 0, since it will be used for synchronization */
+		swapPoolTbl[i].waitCnt = 0; /* initializing the number of processes waiting on the frame */
+		swapPoolTbl[i].prefetched = FALSE; /* initializing the frame's read-ahead flag, since no page has been read ahead */
+		swapPoolTbl[i].dirty = FALSE; /* initializing the frame's dirty flag, since no page has been modified */
+		swapPoolTbl[i].shareable = FALSE; /* initializing the frame's shareable flag, since no .text page has been read */
+		swapPoolTbl[i].sharers = (rmap_t *) NULL; /* initializing the frame's reverse map, since no frame is shared */
+		swapPoolTbl[i].segNo = NOSEG; /* initializing the frame's segment, since no frame holds a segment page */
+	}
+	nextFrameNo = 0; /* initializing the FIFO page replacement algorithm's position in the Swap Pool */
+
+	/* initializing the read-ahead state of each U-proc and the read-ahead daemon's queue */
+	for (i = 0; i < UPROCMAX + 1; i++){
+		raNextPgNo[i] = NOPAGE; /* no U-proc has faulted on a page yet */
+		raWindow[i] = READAHEADINIT; /* every U-proc starts with read-ahead enabled */
+		raSeqCnt[i] = 0; /* no U-proc has taken a sequential page fault yet */
+	}
+	raHead = 0; /* initializing the head of the read-ahead queue */
+	raCount = 0; /* initializing the number of frames in the read-ahead queue, since it is empty */
+	raQueueSem = 0; /* initializing the read-ahead queue's semaphore to 0, since it will be used for synchronization */
+	cleanerSem = 0; /* initializing the page cleaner's semaphore to 0, since it will be used for synchronization */
+	cleanerPending = FALSE; /* the page cleaner has not been woken yet */
+
+	/* initializing the load control state of each U-proc */
+	for (i = 0; i < UPROCMAX + 1; i++){
+		lcFaultCnt[i] = 0; /* no U-proc has taken a page fault yet */
+		lcState[i] = LCACTIVE; /* every U-proc starts out competing for frames */
+		lcResumeSem[i] = 0; /* initializing the U-proc's resume semaphore to 0, since it will be used for synchronization */
+	}
+	lcTick = 0;
+
+	for (i = 0; i < PGTBLPOOLSIZE; i++){
+		pgTblOwner[i] = EMPTYFRAME; /* every table in the pool is initially free */
+	}
+
+	for (i = 0; i < SHMSEGMAX; i++){
+		shmSegTbl[i].key = SHMNOKEY; /* every shared memory segment is initially unused */
+		shmSegTbl[i].attachCnt = 0;
+	}
+
+	/* placing every reverse map entry on the free list */
+	rmapFree_h = (rmap_t *) NULL;
+	pgFaultCnt = 0; /* no page faults have been handled yet */
+	for (i = 0; i < RMAPPOOLSIZE; i++){
+		freeRmap(&(rmapPool[i]));
+	}
+
+	/* initializing the table of identified load images, since no load image has been identified yet */
+	imageSem = 1; /* initializing the semaphore to 1, since it will be used for the purpose of mutual exclusion */
+	for (i = 0; i < UPROCMAX + 1; i++){
+		imageTbl[i].textPgCnt = 0;
+	}
+	nextImageId = NOIMAGE + 1;
+
+	/* initializing the compressed page cache, placing every chunk on the list of free chunks */
+	for (i = 0; i < ZENTRYCNT; i++){
+		zcacheTbl[i].state = ZFREE; /* the cache is initially empty */
+	}
+	for (i = 0; i < ZCHUNKCNT; i++){
+		zNextChunk[i] = i + 1; /* linking chunk i to the chunk that follows it */
+	}
+	zNextChunk[ZCHUNKCNT - 1] = NOCHUNK;
+	zFreeHead = 0;
+	zFreeChunks = ZCHUNKCNT;
+	zSeqNo = 0;
+	zWriteSem = 0; /* initializing the semaphore to 0, since it will be used for synchronization */
+	zWaitCnt = 0;
+
+	/* initializing the mapped regions, since no U-proc has mapped any */
+	for (i = 0; i < (UPROCMAX + 1) * MMAPMAX; i++){
+		mmapTbl[i / MMAPMAX][i % MMAPMAX].pgCnt = 0;
+	}
+
+	/* initializing the pinning state, since no page is pinned */
+	for (i = 0; i < MAXFRAMECNT; i++){
+		swapPoolTbl[i].pinCnt = 0;
+	}
+	for (i = 0; i < (UPROCMAX + 1) * PINQUOTA; i++){
+		pinPgNo[i / PINQUOTA][i % PINQUOTA] = NOPAGE;
+	}
+	for (i = 0; i < UPROCMAX + 1; i++){
+		pinPgCnt[i] = 0;
+	}
+	pinTotal = 0;
+
+	/* initializing the swap area, in which every slot is initially free */
+	for (i = 0; i < SWAPSLOTCNT; i++){
+		slotUsed[i] = FALSE;
+	}
+	for (i = 0; i < (UPROCMAX + 1) * SLOTMAPSIZE; i++){
+		pgSlot[i / SLOTMAPSIZE][i % SLOTMAPSIZE] = NOSLOT; /* no page has been written to swap yet */
+	}
+	swapNextCluster = 0;
+}
+
+/* Function that returns control back to a particular process whose processor state is returnState. This function is used
+primarily as a debugging function. */
+void switchUContext(state_PTR returnState){
+	LDST(returnState); /* returning control back to the desired process */
+}
+
+/* Function that handles page faults that are passed up by the Nucleus. Note that this function utilizes a FIFO page replacement
+algorithm. Now, more specifically, the function obtains a pointer to the Current Process' Support Structure, determines the cause
+of the TLB exception, and then, if the cause is a TLB-Modification exception, passes control to the internal function that marks the
+page as dirty. Next, the function translates the missing VPN into a logical page number (treating an address outside of the Current
+Process' address space, or below the bottom of its stack, as a Program Trap and growing the stack if the page lies just below its
+bottom) and gains mutual exclusion over the Swap Pool table, counts the
+page fault for the load control and, if the load control has chosen the Current Process for suspension, releases the Current Process'
+frames and waits to be resumed. If the table that would hold the missing page's Page Table entry has not been allocated yet, the function
+allocates it. If the missing page holds only .text and another U-proc running the same load image has it in the Swap Pool, the function
+simply maps that frame read-only and returns. A page fault on a page of a shared memory segment is handled the same way as one on a
+private page, except that the frame is owned by the segment's own Page Table entry and the segment's swap slots are used,
+and the Current Process is then added to the frame's reverse map; if the segment page is already in the Swap Pool, the frame is
+simply mapped. If the missing
+page is currently in transit (e.g., it is being written out of a frame that another process selected as a victim), the function waits
+on that frame's semaphore until the transfer completes. The function then selects an idle frame from the Swap Pool using a FIFO page
+replacement algorithm, reserves it by marking it as in transit, and, if the frame is occupied, updates the correct process' Page Table
+(and those of the U-procs sharing the frame) and the TLB. At this point, mutual exclusion over the Swap Pool table is released, so that other page faults can be serviced while this
+one waits on its flash device. The function then writes the evicted page to its swap slot (only if the frame was occupied by a dirty
+page that could not be placed in the compressed page cache) and, unless the missing page can be decompressed from the compressed page
+cache, reads the missing page from its swap slot (or, if it has never been written to swap, from the Current Process' load image) into
+the frame previously selected (or, if the
+page is a stack or .bss page that has never been written to flash, simply zeroes the frame). Finally, the function regains mutual
+exclusion over the Swap Pool table, updates the Current Process' Page Table and the TLB, marks the frame as idle, queues the following
+pages for read-ahead (if the page fault was sequential), wakes the page cleaner (if too few frames are clean) and releases mutual
+exclusion over the Swap Pool table before returning control back to the Current Process to retry the instruction that caused the
+page fault. */
+void vmTlbHandler(){
+	/* declaring local variables */
+	state_PTR savedState; /* a pointer to the saved exception state responsible for the TLB exception */
+	support_t *curProcSupportStruct; /* a pointer to the Current Process' Support Structure */
+	memaddr frameAddr; /* the address of the frame selected by the page replacement algorithm to satisfy the page fault */
+	int exceptionCode; /* the exception code */
+	int missingPgNo; /* the missing page number, as indicated in the saved exception state's EntryHi field */
+	int frameNo; /* the frame number used to satisfy a page fault */
+	int evictAsid; /* the ASID of the U-proc whose page previously occupied the selected frame */
+	int evictPgNo; /* the logical page number of the page that previously occupied the selected frame */
+	int statusCode; /* the status code returned by the flash operations performed on the selected frame */
+	int zeroFill; /* TRUE if the page fault can be satisfied by zeroing the selected frame rather than reading flash */
+	int evictDirty; /* TRUE if the page that previously occupied the selected frame must be written to flash */
+	int fromCache; /* TRUE if the page fault was satisfied from the compressed page cache */
+	pte_entry_t *pte; /* a pointer to the Page Table entry that owns the frame holding the missing page */
+	pte_entry_t *mapPte; /* a pointer to the Current Process' Page Table entry for the missing page */
+	int segNo; /* the shared memory segment that the missing page belongs to (NOSEG if the page is private) */
+	int faultAsid; /* the ASID of the U-proc whose flash device backs the missing page */
+	int faultPgNo; /* the flash block (i.e., the logical page number of that U-proc) backing the missing page */
+
+	curProcSupportStruct = (support_t *) SYSCALL(SYS8NUM, 0, 0, 0); /* obtaining a pointer to the Current Process' Support Structure */
+	savedState = &(curProcSupportStruct->sup_exceptState[PGFAULTEXCEPT]); /* initializing savedState to the state found in the Current Process' Support Structure for TLB exceptions */
+	exceptionCode = ((savedState->s_cause) & GETEXCEPCODE) >> CAUSESHIFT; /* initializing the exception code so that it matches the exception code stored in the .ExcCode field in the Cause register */
+
+	if (exceptionCode == TLBMODEXCCODE){ /* if the exception code indicates that a TLB-Modification exception occurred */
+		handleTlbMod(curProcSupportStruct, savedState); /* invoking the internal function that marks the page as dirty */
+	}
+
+	/* determining the mising page number found in the saved exception state's EntryHI field */
+	missingPgNo = VPNTOPGNO(((savedState->s_entryHI) & GETVPN) >> VPNSHIFT); /* translating the VPN specified in the EntryHI field of the saved exception state into a logical page number */
+	if ((missingPgNo == NOPAGE) || (checkStackAccess(curProcSupportStruct, missingPgNo) == FALSE)){ /* if the address lies outside the Current Process' address space or below the bottom of its stack */
+		programTrapHandler(); /* invoking the function that handles Program Traps in phase 3 */
+	}
+
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to gain mutual exclusion over the Swap Pool table */
+
+	lcFaultCnt[curProcSupportStruct->sup_asid]++; /* counting the page fault for the Pager's load control */
+	pgFaultCnt++; /* counting the page fault for the TLB statistics */
+	if (lcState[curProcSupportStruct->sup_asid] == LCPENDING){ /* if the load control has chosen the Current Process for suspension */
+		suspendUProc(curProcSupportStruct); /* calling the internal helper function to release the Current Process' frames and wait to be resumed */
+	}
+
+	pte = findPte(curProcSupportStruct, missingPgNo); /* locating the Current Process' Page Table entry for the missing page */
+	if (pte == (pte_entry_t *) NULL){ /* if the table that holds the entry has not been allocated yet */
+		if (allocPgTbl(curProcSupportStruct, missingPgNo / ENTRIESPERPG) == FALSE){ /* if there are no tables left in the pool */
+			mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+			programTrapHandler(); /* invoking the function that handles Program Traps in phase 3 */
+		}
+		pte = findPte(curProcSupportStruct, missingPgNo);
+	}
+
+	/* determining which page is missing: a private page of the Current Process, or a page of a shared memory segment that it attached */
+	mapPte = pte;
+	segNo = NOSEG;
+	faultAsid = curProcSupportStruct->sup_asid;
+	faultPgNo = missingPgNo;
+	if ((missingPgNo >= SHMBASEPGNO) && (missingPgNo < LOWPGMAX) && (((pte->entryLO) & PTECOPIEDBITON) == ALLOFF)){ /* if the missing page lies in the shared memory segment window (and is not a private copy of a segment page) */
+		segNo = (missingPgNo - SHMBASEPGNO) / SHMPGMAX; /* the segment that is mapped at the missing page */
+		if ((curProcSupportStruct->sup_shmMode[segNo] == SHMDETACHED) || (((missingPgNo - SHMBASEPGNO) % SHMPGMAX) >= shmSegTbl[segNo].pgCnt)){ /* if the Current Process has not attached the segment, or the page lies beyond its end */
+			mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+			programTrapHandler(); /* invoking the function that handles Program Traps in phase 3 */
+		}
+		faultAsid = shmSegTbl[segNo].backAsid; /* the segment's pages are backed by the flash device of the U-proc that created it */
+		faultPgNo = SHMBLOCKBASE + (missingPgNo - SHMBASEPGNO); /* the flash block backing the segment page */
+		pte = &(shmSegTbl[segNo].pgTbl[(missingPgNo - SHMBASEPGNO) % SHMPGMAX]); /* the segment's own entry owns the frame holding the page */
+	}
+	if ((missingPgNo >= MMAPBASEPGNO) && (missingPgNo < SHMBASEPGNO) && (mmapFind(curProcSupportStruct->sup_asid, missingPgNo) == NOREGION)){ /* if the missing page lies in the mapped region window but the Current Process has not mapped it */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+		programTrapHandler(); /* invoking the function that handles Program Traps in phase 3 */
+	}
+
+	waitForTransit(faultAsid, faultPgNo); /* calling the internal helper function to wait for the missing page's flash transfer to complete, if it is currently in transit */
+
+	if (((mapPte->entryLO) & VBITON) != ALLOFF){ /* if the missing page was made valid while we waited */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+		switchUContext(savedState); /* returning control to the Current Process to retry the instruction that caused the page fault */
+	}
+
+	if ((segNo != NOSEG) && (((pte->entryLO) & VBITON) != ALLOFF)){ /* if the segment page is already in the Swap Pool */
+		frameNo = (((pte->entryLO) & GETPFN) - SWAPPOOLADDR) / PAGESIZE; /* determining the frame holding the page from the segment entry's PFN */
+	}
+	else{
+		frameNo = findSharedFrame(curProcSupportStruct, missingPgNo); /* looking for a frame holding the same .text page of the same load image */
+	}
+	if ((frameNo != NOFRAME) && (addSharer(frameNo, curProcSupportStruct->sup_asid, mapPte) == TRUE)){ /* if the missing page is already in the Swap Pool and was mapped into the Current Process */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+		switchUContext(savedState); /* returning control to the Current Process to retry the instruction that caused the page fault */
+	}
+
+	frameNo = selectVictim(); /* selecting a frame to satisfy the page fault, as determined by Pandos' FIFO page replacement algorithm */
+	frameAddr = SWAPPOOLADDR + (frameNo * PAGESIZE); /* calculating the frameNo's starting address */
+	evictAsid = swapPoolTbl[frameNo].asid; /* remembering the ASID of the page occupying the frame (if any) */
+	evictPgNo = swapPoolTbl[frameNo].pgNo; /* remembering the logical page number of the page occupying the frame (if any) */
+	evictDirty = ((evictAsid != EMPTYFRAME) && (swapPoolTbl[frameNo].dirty == TRUE)); /* a clean page already has an up-to-date copy on flash */
+
+	if (evictAsid != EMPTYFRAME){ /* if the frame selected by the page replacement algorithm is occupied */
+		accountEviction(frameNo); /* calling the internal helper function to adjust the read-ahead window of the U-proc whose page is evicted */
+		setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and its cached counterpart in the TLB atomically */
+		swapPoolTbl[frameNo].ownerProc->entryLO = (swapPoolTbl[frameNo].ownerProc->entryLO) & VBITOFF; /* updating the page table for the process occupying the frame by marking the entry as not valid */
+		if (evictDirty == TRUE){ /* if the page is about to be written out */
+			swapPoolTbl[frameNo].ownerProc->entryLO = (swapPoolTbl[frameNo].ownerProc->entryLO) | PTEBACKEDBITON; /* recording that the page is backed by flash */
+		}
+		tlbInvalidate(swapPoolTbl[frameNo].ownerProc); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+		setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+		unmapSharers(frameNo); /* calling the internal helper function to invalidate the mappings of every U-proc sharing the frame */
+	}
+	if ((evictDirty == TRUE) && (zcacheStore(evictAsid, evictPgNo, frameAddr) == TRUE)){ /* if the evicted page was placed in the compressed page cache */
+		evictDirty = FALSE; /* the page no longer needs to be written to flash */
+	}
+	if (evictDirty == FALSE){ /* if no page is being written out of the frame */
+		evictAsid = EMPTYFRAME; /* no page is in transit out of the frame, so its owner may fault it back in immediately */
+	}
+
+	/* reserving the frame by marking it as in transit and updating the Swap Pool table to reflect the frame's new contents */
+	swapPoolTbl[frameNo].frameState = FRAMEBUSY; /* marking the frame as in transit, so that no other page fault selects it */
+	swapPoolTbl[frameNo].evictAsid = evictAsid; /* recording the ASID of the page being written out of the frame */
+	swapPoolTbl[frameNo].evictPgNo = evictPgNo; /* recording the logical page number of the page being written out of the frame */
+	swapPoolTbl[frameNo].pgNo = faultPgNo; /* updating the page number field for the appropriate frame's entry in the Swap Pool table */
+	swapPoolTbl[frameNo].asid = faultAsid; /* updating the ASID field for the appropriate frame's entry in the Swap Pool table */
+	swapPoolTbl[frameNo].ownerProc = pte; /* updating the ownerProc field in the appropriate frame's entry in the Swap Pool table */
+	swapPoolTbl[frameNo].segNo = segNo; /* recording whether the frame holds a segment page */
+	swapPoolTbl[frameNo].prefetched = FALSE; /* the page is being read in on demand */
+	tagFrame(frameNo, curProcSupportStruct, missingPgNo); /* calling the internal helper function to record whether the frame's page may be shared */
+	if (segNo != NOSEG){ /* if the missing page is a segment page */
+		zeroFill = (((pte->entryLO) & PTEBACKEDBITON) == ALLOFF); /* a segment page has no contents on flash until it is first written back */
+	}
+	else{
+		zeroFill = isZeroFillPage(curProcSupportStruct, missingPgNo); /* determining whether the missing page has any contents on flash */
+	}
+	fromCache = FALSE;
+	if (evictAsid == EMPTYFRAME){ /* if the frame's previous contents need not be written out */
+		fromCache = zcacheLoad(faultAsid, faultPgNo, frameAddr); /* calling the internal helper function to decompress the missing page from the compressed page cache, if it is cached */
+	}
+	else{
+		assignSlot(evictAsid, evictPgNo); /* calling the internal helper function to make sure that the page being written out has a swap slot */
+	}
+	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table while the flash operations are performed */
+
+	statusCode = READY; /* initializing the status code, in case the frame was not occupied by a dirty page */
+	if (evictAsid != EMPTYFRAME){ /* if the frame selected by the page replacement algorithm was occupied by a dirty page */
+		statusCode = writePage(evictAsid, evictPgNo, frameAddr); /* calling the internal helper function to write the page to its swap slot */
+		if (statusCode == READY){ /* if the frame's previous contents were written out successfully */
+			mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to regain mutual exclusion over the Swap Pool table */
+			fromCache = zcacheLoad(faultAsid, faultPgNo, frameAddr); /* calling the internal helper function to decompress the missing page from the compressed page cache, if it is cached */
+			mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
+		}
+	}
+	if ((statusCode == READY) && (fromCache == FALSE) && (zeroFill == TRUE)){ /* if the missing page is being touched for the first time and has no contents on flash */
+		zeroFrame(frameAddr); /* calling the internal helper function to zero the frame instead of reading flash */
+	}
+	else if ((statusCode == READY) && (fromCache == FALSE)){ /* if the missing page was not cached and the frame's previous contents (if any) were written out successfully */
+		statusCode = readPage(faultAsid, faultPgNo, frameAddr); /* calling the internal helper function to read the contents of the missing page (from swap or from its load image) into frame frameNo */
+	}
+
+	mutex(TRUE, (int *) &swapSem); /* calling the internal helper function to regain mutual exclusion over the Swap Pool table */
+
+	if (statusCode != READY){ /* if the read or write operation led to an error status */
+		swapPoolTbl[frameNo].asid = EMPTYFRAME; /* the frame's contents can no longer be trusted, so the frame is marked as unoccupied */
+		releaseFrame(frameNo); /* calling the internal helper function to wake any processes waiting on the frame */
+		mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to make sure we release mutual exclusion over the Swap Pool table */
+		programTrapHandler(); /* invoking the function that handles program traps in phase 3 */
+	}
+
+	setInterrupts(FALSE); /* calling the function that disables interrupts for the Status register so we can update the page table entry and the TLB atomically */
+
+	/* updating the Page Table entry that owns the frame (the Current Process' own entry, unless the page is a segment page) */
+	pte->entryLO = frameAddr | VBITON | ((pte->entryLO) & PTEBACKEDBITON); /* ensuring the V bit is on and that the PFN field of the appropriate Page Table entry for the Current Process is updated (without forgetting whether the page is backed by flash) */
+	swapPoolTbl[frameNo].dirty = ((zeroFill == TRUE) || (fromCache == TRUE)); /* a zero-filled or decompressed page has no up-to-date copy on flash, so it is dirty from the start */
+	if (swapPoolTbl[frameNo].dirty == TRUE){ /* if the frame was zero-filled or decompressed */
+		pte->entryLO = (pte->entryLO) | DBITON; /* turning the D bit on, since the frame is already dirty */
+	}
+
+	tlbInvalidate(pte); /* calling the nucleus function that removes the entry's cached copies from the TLB and the software TLB */
+	setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+	if ((missingPgNo == 0) && (curProcSupportStruct->sup_imagePgCnt == IMAGEUNKNOWN)){ /* if the page that was just read begins with the U-proc's aout header */
+		identifyImage(curProcSupportStruct, recordImageBounds(curProcSupportStruct, (unsigned int *) frameAddr)); /* calling the internal helper functions to record the bounds of the load image and to identify it (the frame stays in transit, so it is not replaced meanwhile) */
+		tagFrame(frameNo, curProcSupportStruct, missingPgNo); /* now that the load image is known, logical page 0 may be shared */
+	}
+	if (segNo != NOSEG){ /* if the missing page is a segment page */
+		addSharer(frameNo, curProcSupportStruct->sup_asid, mapPte); /* calling the internal helper function to map the frame into the Current Process (the pool of reverse map entries is large enough for every U-proc to map every segment page) */
+	}
+	releaseFrame(frameNo); /* calling the internal helper function to mark the frame as idle and wake any processes waiting on it */
+	if (segNo == NOSEG){ /* if the missing page is one of the Current Process' own pages */
+		readAhead(curProcSupportStruct, missingPgNo); /* calling the internal helper function to read ahead the pages following the missing page, if the page fault was sequential */
+	}
+	checkWatermark(); /* calling the internal helper function to wake the page cleaner, if too few frames are clean */
 	mutex(FALSE, (int *) &swapSem); /* calling the internal helper function to release mutual exclusion over the Swap Pool table */
 	switchUContext(savedState); /* calling the internal helper function to return control to the Current Process to retry the instruction that caused the page fault */
 }
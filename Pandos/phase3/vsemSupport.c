@@ -0,0 +1,177 @@
+/**************************************************************************** 
+ *
+ * This module implements the virtual semaphores of SYS19 and SYS20, whose
+ * values are integers in the requesting U-proc's logical address space (so
+ * that U-procs sharing a segment can synchronize through semaphores placed
+ * in it). Both operations run with interrupts disabled, which makes them
+ * atomic with respect to every other process, and so an operation that does
+ * not block or unblock a U-proc costs no Nucleus SYSCALL. Since the page
+ * holding the semaphore must not fault while interrupts are disabled, the
+ * operation first makes sure (with interrupts enabled) that the page is
+ * resident and writable.
+ *
+ * The U-procs blocked on a virtual semaphore are kept on the support level's
+ * own ASL: a hash table of semaphore descriptors keyed by (ASID, virtual
+ * address), each holding a FIFO queue of the ASIDs of its blocked U-procs.
+ * A blocked U-proc waits on its private semaphore, which the U-proc that
+ * performs the matching V operation signals.
+ *  
+ * Written by: Kollen Gruizenga and Jake Heyser
+ ****************************************************************************/
+
+#include "../h/asl.h"
+#include "../h/pcb.h"
+#include "../h/scheduler.h"
+#include "../h/exceptions.h"
+#include "../h/interrupts.h"
+#include "../h/initial.h"
+#include "../h/types.h"
+#include "../h/const.h"
+#include "../h/initProc.h"
+#include "../h/vmSupport.h"
+#include "../h/vsemSupport.h"
+#include "/usr/include/umps3/umps/libumps.h"
+
+/* function declarations */
+HIDDEN int vsemKey(support_t *supportStruct, memaddr semAdd); /* function declaration for the function that determines the ASID by which a semaphore is keyed */
+HIDDEN int vsemAcquire(support_t *supportStruct, memaddr semAdd); /* function declaration for the function that disables interrupts once a semaphore can be updated */
+HIDDEN vsemd_t *vsemFind(int asid, memaddr semAdd); /* function declaration for the function that finds a semaphore's descriptor */
+
+/* declaring variables that are global to this module */
+HIDDEN vsemd_t vsemdTable[UPROCMAX]; /* the semaphore descriptors */
+HIDDEN vsemd_t *vsemdFree_h; /* the list of unused semaphore descriptors */
+HIDDEN vsemd_t *vsemHash[VSEMHASHSIZE]; /* the hash table of active semaphore descriptors */
+HIDDEN int vsemNext[UPROCMAX + 1]; /* the ASID of the U-proc after each blocked U-proc in its semaphore's queue (NOUPROC if it is the last) */
+HIDDEN int vsemPrivSem[UPROCMAX + 1]; /* the private semaphore on which each blocked U-proc waits */
+
+/* Function that initializes the support level's ASL. This function is called once by test() in initProc.c. */
+void initVsemStructs(){
+	int i; /* loop variable */
+
+	vsemdFree_h = (vsemd_t *) NULL;
+	for (i = 0; i < UPROCMAX; i++){ /* placing every descriptor on the free list */
+		vsemdTable[i].v_next = vsemdFree_h;
+		vsemdFree_h = &(vsemdTable[i]);
+	}
+	for (i = 0; i < VSEMHASHSIZE; i++){
+		vsemHash[i] = (vsemd_t *) NULL;
+	}
+	for (i = 0; i < UPROCMAX + 1; i++){
+		vsemNext[i] = NOUPROC;
+		vsemPrivSem[i] = 0; /* synchronization semaphore */
+	}
+}
+
+/* Internal helper function that returns the ASID by which the semaphore at semAdd of the U-proc with Support Structure supportStruct is keyed:
+VSEMSHAREDASID if the semaphore lies in a shared memory segment the U-proc attached SHMSHARED, or the U-proc's own ASID otherwise. */
+int vsemKey(support_t *supportStruct, memaddr semAdd){
+	/* declaring local variables */
+	int pgNo; /* the logical page number of the page holding the semaphore */
+
+	pgNo = VPNTOPGNO((semAdd & GETVPN) >> VPNSHIFT); /* translating the semaphore's VPN into a logical page number */
+	if ((pgNo != NOPAGE) && (pgNo >= SHMBASEPGNO) && (pgNo < LOWPGMAX) && (supportStruct->sup_shmMode[(pgNo - SHMBASEPGNO) / SHMPGMAX] == SHMSHARED)){
+		return VSEMSHAREDASID;
+	}
+	return supportStruct->sup_asid;
+}
+
+/* Internal helper function that returns with interrupts disabled once the U-proc with Support Structure supportStruct can store into the
+semaphore at semAdd without raising an exception. While the page is not writable, it enables interrupts and calls makeWritable() in
+vmSupport.c to fault the page in. The function returns FALSE (with interrupts enabled) if the semaphore does not lie in a writable page
+of the U-proc's address space. */
+int vsemAcquire(support_t *supportStruct, memaddr semAdd){
+	setInterrupts(FALSE); /* calling the function that disables interrupts so that the semaphore can be examined and updated atomically */
+	while (!pageWritable(supportStruct, semAdd)){ /* while a store into the semaphore would raise an exception */
+		setInterrupts(TRUE); /* calling the function that enables interrupts, since making the page writable may require flash I/O */
+		if (makeWritable(supportStruct, semAdd) == FALSE){ /* calling the function in vmSupport.c that faults the page in and turns its D bit on */
+			return FALSE;
+		}
+		setInterrupts(FALSE);
+	}
+	return TRUE;
+}
+
+/* Internal helper function that returns the descriptor of the semaphore at semAdd keyed by ASID asid, or NULL if no U-proc is blocked on it.
+Note that the caller must have interrupts disabled. */
+vsemd_t *vsemFind(int asid, memaddr semAdd){
+	vsemd_t *semd; /* the descriptor being examined */
+
+	semd = vsemHash[VSEMHASH(asid, semAdd)];
+	while ((semd != (vsemd_t *) NULL) && ((semd->v_asid != asid) || (semd->v_semAdd != semAdd))){
+		semd = semd->v_next;
+	}
+	return semd;
+}
+
+/* Function that performs a P operation on the virtual semaphore at semAdd on behalf of the U-proc with Support Structure supportStruct.
+If the semaphore's value becomes negative, the U-proc is appended to the semaphore's queue on the support level's ASL (allocating a
+descriptor if it is the first) and waits on its private semaphore until a V operation unblocks it. The function returns FALSE if the
+semaphore does not lie in a writable page of the U-proc's address space. */
+int vsemP(support_t *supportStruct, memaddr semAdd){
+	/* declaring local variables */
+	int key; /* the ASID by which the semaphore is keyed */
+	int asid; /* the U-proc's ASID */
+	vsemd_t *semd; /* the semaphore's descriptor */
+
+	if (vsemAcquire(supportStruct, semAdd) == FALSE){ /* calling the internal helper function to disable interrupts once the semaphore is writable */
+		return FALSE;
+	}
+	(*((int *) semAdd))--;
+	if (*((int *) semAdd) < 0){ /* if the U-proc must block */
+		key = vsemKey(supportStruct, semAdd);
+		asid = supportStruct->sup_asid;
+		semd = vsemFind(key, semAdd); /* calling the internal helper function to find the semaphore's descriptor */
+		if (semd == (vsemd_t *) NULL){ /* if no U-proc is blocked on the semaphore, allocate it a descriptor */
+			semd = vsemdFree_h;
+			vsemdFree_h = semd->v_next;
+			semd->v_asid = key;
+			semd->v_semAdd = semAdd;
+			semd->v_head = asid;
+			semd->v_next = vsemHash[VSEMHASH(key, semAdd)];
+			vsemHash[VSEMHASH(key, semAdd)] = semd;
+		}
+		else{
+			vsemNext[semd->v_tail] = asid;
+		}
+		semd->v_tail = asid;
+		vsemNext[asid] = NOUPROC;
+		SYSCALL(SYS3NUM, (unsigned int) &(vsemPrivSem[asid]), 0, 0); /* waiting on the U-proc's private semaphore (interrupts stay disabled until the U-proc resumes) */
+	}
+	setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+	return TRUE;
+}
+
+/* Function that performs a V operation on the virtual semaphore at semAdd on behalf of the U-proc with Support Structure supportStruct.
+If a U-proc is blocked on the semaphore, the first one is removed from the semaphore's queue on the support level's ASL (freeing the
+descriptor if the queue empties) and its private semaphore is signalled. The function returns FALSE if the semaphore does not lie in
+a writable page of the U-proc's address space. */
+int vsemV(support_t *supportStruct, memaddr semAdd){
+	/* declaring local variables */
+	int key; /* the ASID by which the semaphore is keyed */
+	int asid; /* the ASID of the U-proc that is unblocked */
+	vsemd_t *semd; /* the semaphore's descriptor */
+	vsemd_t **link; /* the link in the hash bucket that points to the descriptor */
+
+	if (vsemAcquire(supportStruct, semAdd) == FALSE){ /* calling the internal helper function to disable interrupts once the semaphore is writable */
+		return FALSE;
+	}
+	(*((int *) semAdd))++;
+	key = vsemKey(supportStruct, semAdd);
+	semd = vsemFind(key, semAdd); /* calling the internal helper function to find the semaphore's descriptor */
+	if (semd != (vsemd_t *) NULL){ /* if a U-proc is blocked on the semaphore, unblock the first one */
+		asid = semd->v_head;
+		semd->v_head = vsemNext[asid];
+		if (semd->v_head == NOUPROC){ /* if the queue is now empty, return the descriptor to the free list */
+			link = &(vsemHash[VSEMHASH(key, semAdd)]);
+			while (*link != semd){
+				link = &((*link)->v_next);
+			}
+			*link = semd->v_next;
+			semd->v_next = vsemdFree_h;
+			vsemdFree_h = semd;
+		}
+		SYSCALL(SYS4NUM, (unsigned int) &(vsemPrivSem[asid]), 0, 0); /* signalling the unblocked U-proc's private semaphore */
+	}
+	setInterrupts(TRUE); /* calling the function that enables interrupts for the Status register, since the atomically-executed steps have now been completed */
+	return TRUE;
+}